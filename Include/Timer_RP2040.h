@@ -18,6 +18,8 @@
   Revision |  Author   |  Change ID  |  Description
   01.01.00 |  Madrick3 |  Skeleton   |  Initial Creation
 ************************************************************/
+#if !defined( TIMER_RP2040_H )
+#define TIMER_RP2040_H
 
 /************************************************************
   DEFINES
@@ -32,6 +34,68 @@
 #define TIMER_RP2040_ALLALARMS_BITMASK 0x0000000F
 #define TIMER_RP2040_ALLINTERRUPTS_BITMASK TIMER_RP2040_ALLALARMS_BITMASK
 
+/* Half of the 32 bit time range - wrap-safe comparisons treat smaller differences as 'not later' */
+#define TIMER_RP2040_HALF_RANGE32 0x80000000uL
+
+/*
+  Longest distance an ALARMn comparator is ever armed into the future. ALARMn only compares 32 bits, so 64 bit
+  deadlines further out than this are reached through intermediate wakes.
+*/
+#define TIMER_RP2040_ALARM_WINDOW_US 0x7FFFFFFFuL
+
+/*
+  Tickless systems do not want the periodic 1ms ALARM0 tick - Timer_RP2040_Init leaves every alarm disarmed, and the
+  scheduler programs its alarm for real events only.
+*/
+#if !defined( TIMER_RP2040_TICKLESS )
+#define TIMER_RP2040_TICKLESS 0
+#endif
+
+/*
+  Alarm interrupt latency instrumentation: Timer_RP2040_IrqHandler records how late each callback runs relative to
+  the programmed ALARMn value. Compiles to nothing when 0.
+*/
+#if !defined( TIMER_RP2040_LATENCY_STATS )
+#define TIMER_RP2040_LATENCY_STATS 0
+#endif
+
+/* Latency histogram buckets: bucket 0 counts 0us, bucket k counts [2^(k-1), 2^k) us */
+#define TIMER_RP2040_LATENCY_BUCKETS 33
+
+/*
+  Shadow registers: the driver owned configuration - INTE and the ALARMn values it wrote - is mirrored in SRAM, and
+  status queries are answered from the copy instead of a peripheral bus read. Bits the hardware changes by itself
+  (INTR, INTS, ARMED) are still read from the TIMER. Writes to the TIMER which bypass the driver must be followed by
+  Timer_RP2040_ShadowSync.
+*/
+#if !defined( TIMER_RP2040_SHADOW )
+#define TIMER_RP2040_SHADOW 0
+#endif
+
+/*
+  Debug builds route the inline time accessors through the checked API, release builds read the registers directly.
+*/
+#if !defined( TIMER_RP2040_DEBUG )
+#define TIMER_RP2040_DEBUG 0
+#endif
+
+/* Header defined helpers - C89 has no inline keyword, so the compiler extension is used where available. */
+#if defined( __GNUC__ )
+#define TIMER_RP2040_INLINE static __inline__
+#else
+#define TIMER_RP2040_INLINE static
+#endif
+
+/*
+  Full memory barrier for data shared between an interrupt, the main loop and the other core. The host build uses the
+  compiler builtin so that the virtual target can be exercised from several threads.
+*/
+#if !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_MEMORY_BARRIER() __asm__ __volatile__ ( "dmb" : : : "memory" )
+#else
+#define TIMER_RP2040_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
 #if !defined( VIRTUAL_TARGET )
 #define TIMER_RP2040_LOCAL static
 #else
@@ -43,6 +107,7 @@
 ************************************************************/
 #include "Platform_Types.h"
 #include "Timer_RP2040_SFR.h"
+#include "Timer_RP2040_Lock.h"
 #include "Watchdog_RP2040.h"
 
 /************************************************************
@@ -56,7 +121,10 @@ typedef enum Timer_RP2040_Status_Tag {
   TIMER_RP2040_INVALID = 0xFF
 } tTimer_RP2040_Status;
 
-/* Check alarm status results - useful for polling mode where we want to see if an alarm has been triggered */
+/*
+  Check alarm status results - useful for polling mode where we want to see if an alarm has been triggered. Polled
+  alarms keep their interrupt disabled, Timer_RP2040_IrqHandler acknowledges every enabled one.
+*/
 typedef enum Timer_RP2040_AlarmStatus_Tag {
   /* Alarm not set and Interrupt not set */
   TIMER_RP2040_ALARM_NOT_SET =           0,
@@ -64,10 +132,41 @@ typedef enum Timer_RP2040_AlarmStatus_Tag {
   TIMER_RP2040_ALARM_SET_NOT_TRIGGERED = 1,
   /* Interrupt flag for alarm is set */
   TIMER_RP2040_ALARM_TRIGGERED =         2,
+  /* The deadline had already passed when the alarm was armed - see Timer_RP2040_TryArmAlarmN */
+  TIMER_RP2040_ALARM_EXPIRED =           3,
   /* Something has gone wrong or an invalid request was made */
   TIMER_RP2040_ALARM_FAILED =            0xFF
 } tTimer_RP2040_AlarmStatus;
 
+/*
+  Alarm interrupt callback, executed from Timer_RP2040_IrqHandler once the alarm's interrupt has been acknowledged.
+  'alarmIndex' is the alarm which fired, 'context' is the pointer given at registration.
+*/
+typedef void (*tTimer_RP2040_AlarmCallback)( uint8 alarmIndex, void * context );
+
+/* State of all four alarms at one point in time, see Timer_RP2040_CheckAlarms. One bit per alarm. */
+typedef struct Timer_RP2040_AlarmSnapshot_Tag {
+  /* Waiting for the comparator to match (ARMED) */
+  uint32 armed;
+  /* Deadline reached: the comparator matched (INTR), or the deadline had passed when armed */
+  uint32 fired;
+  /* Interrupt asserted towards the NVIC (INTS) - fired or forced, and enabled */
+  uint32 pending;
+} tTimer_RP2040_AlarmSnapshot;
+
+/* Interrupt latency statistics of one alarm, see Timer_RP2040_LatencySnapshot. All times in microseconds. */
+typedef struct Timer_RP2040_LatencyStats_Tag {
+  /* Callbacks recorded */
+  uint32 count;
+  uint32 min;
+  uint32 max;
+  /* Sum of all latencies - mean is sum / count */
+  uint64 sum;
+  uint32 mean;
+  /* log2 histogram, see TIMER_RP2040_LATENCY_BUCKETS */
+  uint32 bucket[TIMER_RP2040_LATENCY_BUCKETS];
+} tTimer_RP2040_LatencyStats;
+
 /************************************************************
   EXTERN FUNCTIONS
 ************************************************************/
@@ -81,8 +180,8 @@ typedef enum Timer_RP2040_AlarmStatus_Tag {
 ************************************************************/
 
 /**
- * Initializes the timer module for a basic runtime implemetations: Arms ALARM0 as a 1ms timer, clears TIME, and begins
- * the timer. Can fail if the RP2040_Watchdog is not already initialized. (See RP2040 datasheet section 4.7.2 'Tick
+ * Initializes the timer module for a basic runtime implemetations: Arms ALARM0 as a 1ms timer (unless
+ * TIMER_RP2040_TICKLESS is set), clears TIME, and begins the timer. Can fail if the RP2040_Watchdog is not already initialized. (See RP2040 datasheet section 4.7.2 'Tick
  * Generation'). Interrupts are not necessarily enabled at this stage.
  *
  * @return 
@@ -90,7 +189,7 @@ typedef enum Timer_RP2040_AlarmStatus_Tag {
  *         1: 'E_NOT_OK' if the operation is not successful
  *
  * @pre  Tick generation is already started in the watchdog module. 
- * @post  ALARM0 is armed. 
+ * @post  ALARM0 is armed (unless TIMER_RP2040_TICKLESS is set). 
  * @invariant n/a
  *
  */
@@ -113,6 +212,21 @@ extern Std_ErrorCode Timer_RP2040_Init ( void );
  */
 extern Std_ErrorCode Timer_RP2040_Deinit ( void );
 
+/**
+ * Reports the init status of the timer module, so that layers built on top of the driver can perform the same
+ * pre-checks as the driver itself.
+ *
+ * @return 
+ *         0: 'TIMER_RP2040_UNINIT' if the timer is not yet initialized
+ *         1: 'TIMER_RP2040_INIT' if the timer is initialized
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern tTimer_RP2040_Status Timer_RP2040_IsInit ( void );
+
 /**
  * Writes directly to the TIMER_INTE register, given an uint8 bitmask. Will report a parameter failure if the bitmask
  * parameter is not within the acceptable range [1,15]. Will not disable, clear, or otherwise touch alarms.
@@ -149,12 +263,41 @@ extern Std_ErrorCode Timer_RP2040_InterruptEnable ( uint32 bmp_intEnable );
  */
 extern Std_ErrorCode Timer_RP2040_InterruptDisable ( uint8  bmp_intDisable );
 
+/**
+ * Reports the alarm interrupts which are enabled - from the shadow copy with TIMER_RP2040_SHADOW, from INTE otherwise.
+ *
+ * @return 
+ *         Bitmap of the enabled alarm interrupts.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_InterruptEnabled ( void );
+
+#if ( TIMER_RP2040_SHADOW != 0 )
+/**
+ * Reloads the shadow registers from INTE and ALARMn. Called by Timer_RP2040_Init - only needed again when the TIMER
+ * was written behind the driver's back, e.g. by a debugger or a boot loader.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre n/a
+ * @post The shadow registers match the TIMER.
+ * @invariant n/a
+ *
+ */
+extern void Timer_RP2040_ShadowSync ( void );
+#endif
+
 extern Std_ErrorCode Timer_RP2040_InterruptNTrigger ( uint8 intToTrigger );
 extern tTimer_RP2040_AlarmStatus Timer_RP2040_InterruptNStatusCheck (  uint8 interrupt_to_check );
 
 /**
- * Reads from TIMER_TIMELR and TIMER_TIMEHR. Is not threadsafe - future improvements can be made by utilizing the RAWL
- * and RAWH registers instead. This read is not threadsafe, and enforces latching on the timer, so interrupts should
+ * Reads from TIMER_TIMELR and TIMER_TIMEHR. Is not threadsafe - use Timer_RP2040_TimerRead64 instead, which reads
+ * the RAWL and RAWH registers. This read is not threadsafe, and enforces latching on the timer, so interrupts should
  * be stopped specifically during this read.
  * @param TimerHigh: Pointer to where timer bits [63:32] will be stored.
  * @param TimerLow: Pointer to where timer bits [31:0] will be stored.
@@ -210,7 +353,24 @@ extern Std_ErrorCode Timer_RP2040_TimerWrite (  uint32 *  TimerHigh,  uint32 *
 extern Std_ErrorCode Timer_RP2040_TimerRead32 (  uint32 *  TimerLow );
 
 /**
- * Checks alarm 'n' to see if it has been triggered yet. Returns '1' if
+ * Reads the full 64 bit time from TIMER_TIMERAWH and TIMER_TIMERAWL without using the TIMEHR/TIMELR latch. TIMERAWH
+ * is read before and after TIMERAWL, and the read is repeated if the low word carried in between. Does not lock,
+ * mask interrupts or cause any side-effects, so it is safe from any interrupt and from both cores. No init check is
+ * performed, so that it may be used as the hot path for timestamps.
+ *
+ * @return 
+ *         Current time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_TimerRead64 ( void );
+
+/**
+ * Checks alarm 'n' to see if it has been triggered yet. The status comes from ARMED and from the raw or forced
+ * interrupt flag - any ALARMn value, 0 included, is a valid trigger time.
  * @param alarmIndex: Index of Alarm to be disarmed, must be within range [0:3].
  *
  * @return 
@@ -224,6 +384,24 @@ extern Std_ErrorCode Timer_RP2040_TimerRead32 (  uint32 *  TimerLow );
  */
 extern tTimer_RP2040_AlarmStatus Timer_RP2040_CheckAlarmN (  uint8  alarmIndex );
 
+/**
+ * Checks all four alarms at once for polling main loops: ARMED, INTR and INTS are each read a single time, ARMED
+ * first, so an alarm which matches during the snapshot is reported armed and fired, never neither. The fired alarms
+ * may be acknowledged in the same call with a single INTR write.
+ * @param snapshot: Receives the alarm state bitmaps.
+ * @param acknowledge: Non-zero to clear the interrupt of every alarm reported as fired.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post With 'acknowledge', the fired alarms no longer raise an interrupt.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_CheckAlarms ( tTimer_RP2040_AlarmSnapshot * snapshot, uint8 acknowledge );
+
 /**
  * Disables the alarm indicated by index 'alarmIndex'. rites to the TIMER_ARMED register to disarm the alarm indicated
  * by the 'alarmIndex'. Reports OK if successful, and NOT_OK if failed. Checks input parameter is within range [0:3]
@@ -244,23 +422,119 @@ extern Std_ErrorCode Timer_RP2040_DisarmAlarmN (  uint8  alarmIndex );
 
 
 /**
- * Disables the alarm indicated by index 'alarmIndex'. rites to the TIMER_ARMED register to disarm the alarm indicated
- * by the 'alarmIndex'. Reports OK if successful, and NOT_OK if failed. Checks input parameter is within range [0:3]
- * @param alarmIndex: Index of Alarm to be checked, must be within range [0:3].
+ * Arms the alarm indicated by index 'alarmIndex' for 'triggerTime'. If the time has already reached 'triggerTime' when
+ * the write lands, the comparator would only match after a full 2^32 us wrap - instead the alarm is disarmed again and
+ * its interrupt is forced through INTF, so it fires right away. 0 is a valid trigger time.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param triggerTime: 32 bit value for the alarm. The alarm will trigger when TIMER_ALARMn == TIMER_TIMELR.
  *
  * @return 
  *         0: 'E_OK' if successful 
- *         1: 'E_NOT_OK' if the operation is not successful 
  *         2: 'E_PARAM' if the input parameter is not valid 
- *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
  *
- * @pre n/a
- * @post n/a
+ * @pre 'triggerTime' is less than 2^31 us (about 35 minutes) from the current time - further in the future reads as
+ *      a passed deadline.
+ * @post The alarm is armed, or its interrupt is pending.
  * @invariant n/a
  *
  */
 extern Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 triggerTime );
 
+/**
+ * Arms the alarm indicated by index 'alarmIndex' for 'triggerTime' like Timer_RP2040_ArmAlarmN, but reports a passed
+ * deadline instead of forcing the interrupt - the alarm is left disarmed.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param triggerTime: 32 bit value for the alarm.
+ *
+ * @return 
+ *         1: 'TIMER_RP2040_ALARM_SET_NOT_TRIGGERED' if the alarm is armed
+ *         3: 'TIMER_RP2040_ALARM_EXPIRED' if the deadline had already passed
+ *         0xFF: 'TIMER_RP2040_ALARM_FAILED' if the input parameter is not valid
+ *
+ * @pre 'triggerTime' is less than 2^31 us from the current time.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern tTimer_RP2040_AlarmStatus Timer_RP2040_TryArmAlarmN ( uint8 alarmIndex, uint32 triggerTime );
+
+/**
+ * Arms the alarm indicated by index 'alarmIndex' for 'delta' microseconds from now. Replaces reading the time and
+ * calling Timer_RP2040_ArmAlarmN with the sum: the time read and the comparator write happen back to back in one
+ * critical section. A deadline which passes before the write lands forces the interrupt as in Timer_RP2040_ArmAlarmN,
+ * so a 'delta' of 0 fires the alarm at once.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param delta: Microseconds from now, must be below TIMER_RP2040_HALF_RANGE32.
+ * @param triggerTime: Receives the absolute 32 bit deadline written to TIMER_ALARMn, may be NULL.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *
+ * @pre n/a
+ * @post The alarm is armed, or its interrupt is pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ArmAlarmRelative ( uint8 alarmIndex, uint32 delta, uint32 * triggerTime );
+
+/**
+ * Arms several alarms together, e.g. for outputs that must switch in lockstep. Each comparator still needs its own
+ * ALARMn write, but the writes are issued back to back in one critical section and the deadlines are checked against
+ * a single read of the time and of ARMED. Passed deadlines force the interrupt as in Timer_RP2040_ArmAlarmN.
+ * @param alarmBitmap: Alarms to arm, bit n for alarm n. Must be non-zero and within TIMER_RP2040_ALLALARMS_BITMASK.
+ * @param triggerTimes: 32 bit values indexed by alarm index, e.g. triggerTimes[2] for alarm 2. Only the entries of
+ *                      the alarms in 'alarmBitmap' are read.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *
+ * @pre Each used 'triggerTimes' entry is less than 2^31 us from the current time.
+ * @post The alarms are armed, or their interrupts are pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ArmAlarms ( uint32 alarmBitmap, const uint32 * triggerTimes );
+
+/**
+ * Disarms several alarms with a single write of the TIMER_ARMED register.
+ * @param alarmBitmap: Alarms to disarm, bit n for alarm n. Must be non-zero and within
+ *                     TIMER_RP2040_ALLALARMS_BITMASK.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *
+ * @pre n/a
+ * @post The alarms are disarmed and none of their interrupts is forced.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DisarmAlarms ( uint32 alarmBitmap );
+
+/**
+ * Arms the alarm indicated by 'alarmIndex' for a 64 bit absolute deadline, which may be any distance away. A deadline
+ * within TIMER_RP2040_ALARM_WINDOW_US is armed on the comparator directly. A deadline further out is parked: the
+ * comparator is armed for an intermediate wake, and Timer_RP2040_IrqHandler re-evaluates the deadline each time it
+ * fires, without running the alarm callback, until the deadline falls inside the window. Parked deadlines therefore
+ * need the IRQ handler installed and the alarm interrupt enabled. Without a callback the expiry is handed over to
+ * polling, see Timer_RP2040_IrqHandler - the interrupt is enabled again before the next parked deadline.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param deadline: Absolute time in microseconds.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm is armed for the deadline or for an intermediate wake, or its interrupt is forced if the deadline
+ *       has passed.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ArmAlarmAt64 ( uint8 alarmIndex, uint64 deadline );
+
 /**
  * Clear timer interrupt N
  * @param interruptIndex: Index of the interrupt to be cleared (0:3)
@@ -273,3 +547,255 @@ extern Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 trigger
  */
 extern Std_ErrorCode Timer_RP2040_InterruptClearN( uint8 interruptIndex );
 
+/**
+ * Registers the callback executed by Timer_RP2040_IrqHandler for alarm 'alarmIndex'. A NULL callback removes the
+ * registration. Registration should be done while the alarm interrupt is disabled.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param callback: Function called when the alarm interrupt is serviced, or NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm interrupt is serviced by the callback (or only acknowledged if the callback is NULL).
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_RegisterCallback ( uint8 alarmIndex, tTimer_RP2040_AlarmCallback callback,
+                                                     void * context );
+
+/**
+ * TIMER_IRQ entry point - may be placed directly in the vector table. Reads TIMER_INTS once, acknowledges every
+ * pending alarm in a single TIMER_INTR write and withdraws forced interrupts from TIMER_INTF, then calls the callbacks
+ * in alarm index order. TIMER_IRQ is level sensitive, so alarms without a callback are acknowledged as well and handed
+ * over to polling: their interrupt is disabled and the expiry kept as a forced flag, which Timer_RP2040_CheckAlarmN
+ * reports as triggered. Alarms which are polled from the start keep their interrupt disabled.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre n/a
+ * @post Alarm interrupts which were pending are cleared.
+ * @invariant n/a
+ *
+ */
+extern void Timer_RP2040_IrqHandler ( void );
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/**
+ * Copies the interrupt latency statistics of alarm 'alarmIndex': the time from the programmed ALARMn value to the
+ * entry of its callback in Timer_RP2040_IrqHandler. The copy is consistent even if the alarm fires meanwhile.
+ * Interrupts raised with Timer_RP2040_InterruptNTrigger have no deadline and are not counted.
+ * Only available with TIMER_RP2040_LATENCY_STATS.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param stats: Receives the statistics.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_LatencySnapshot ( uint8 alarmIndex, tTimer_RP2040_LatencyStats * stats );
+
+/**
+ * Clears the interrupt latency statistics of alarm 'alarmIndex'. Only available with TIMER_RP2040_LATENCY_STATS.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post No latency is recorded for the alarm.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_LatencyReset ( uint8 alarmIndex );
+#endif
+
+/**
+ * Starts a drift-free periodic alarm. Each deadline is re-armed from the previous absolute deadline (deadline +=
+ * period), so long-term rate is exact and interrupt latency only shows as jitter. Periods missed because the interrupt
+ * was serviced late are skipped and counted, see Timer_RP2040_PeriodicSkipped. 'callback' runs from
+ * Timer_RP2040_IrqHandler, which must be installed and the alarm interrupt enabled by the caller.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param period: Period in microseconds, must be within range [1:2^31 - 1].
+ * @param callback: Function called once per period, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The alarm is armed one period from now.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_PeriodicStart ( uint8 alarmIndex, uint32 period,
+                                                  tTimer_RP2040_AlarmCallback callback, void * context );
+
+/**
+ * Stops a periodic alarm: the alarm is disarmed, a period which has already matched is withdrawn and the callback is
+ * removed. A period being serviced on the other core at the same time does not re-arm the alarm.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm is disarmed, its interrupt is not pending and it has no callback.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_PeriodicStop ( uint8 alarmIndex );
+
+/**
+ * Reports the number of periods a periodic alarm has skipped because its interrupt was serviced after the following
+ * deadline had already passed.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         Skipped periods since Timer_RP2040_PeriodicStart, 0 for an invalid index.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_PeriodicSkipped ( uint8 alarmIndex );
+
+/************************************************************
+  INLINE FUNCTIONS
+************************************************************/
+
+/**
+ * Driver internal read of the low 32 bits of the time: a single TIMER_TIMERAWL load in every build, so that deadline
+ * decisions do not depend on TIMER_RP2040_DEBUG. Applications use Timer_RP2040_Now32.
+ *
+ * @return 
+ *         Low 32 bits of the current time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_RawNow32 ( void )
+{
+  return TIMER_REG_READ(TIMER_REG_TIMERAWL);
+}
+
+/**
+ * Driver internal read of the full 64 bit time with the high-low-high sequence, unchecked in every build.
+ * Applications use Timer_RP2040_Now64.
+ *
+ * @return 
+ *         Current time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_RawNow64 ( void )
+{
+  uint32 timeHigh;
+  uint32 timeLow;
+  uint32 timeHighCheck;
+
+  timeHighCheck = TIMER_REG_READ(TIMER_REG_TIMERAWH);
+  do
+  {
+    timeHigh = timeHighCheck;
+    timeLow = TIMER_REG_READ(TIMER_REG_TIMERAWL);
+    timeHighCheck = TIMER_REG_READ(TIMER_REG_TIMERAWH);
+  } while( timeHigh != timeHighCheck );
+
+  return (((uint64)timeHigh) << 32) | (uint64)timeLow;
+}
+
+/**
+ * Fast path read of the low 32 bits of the time, for polling loops and timestamps. Release builds compile to a single
+ * TIMER_TIMERAWL load with no checks. Debug builds check the init status and use Timer_RP2040_TimerRead32, and
+ * report 0 if the timer is not initialized.
+ *
+ * @return 
+ *         Low 32 bits of the current time in microseconds.
+ *
+ * @pre Timer module was previously enabled.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_Now32 ( void )
+{
+#if ( TIMER_RP2040_DEBUG != 0 )
+  uint32 time = ZERO32;
+
+  if( (TIMER_RP2040_INIT != Timer_RP2040_IsInit()) || (E_OK != Timer_RP2040_TimerRead32(&time)) )
+  {
+    time = ZERO32;
+  }
+
+  return time;
+#else
+  return Timer_RP2040_RawNow32();
+#endif
+}
+
+/**
+ * Fast path read of the full 64 bit time, see Timer_RP2040_TimerRead64. Release builds expand the high-low-high read
+ * in place. Debug builds report 0 if the timer is not initialized.
+ *
+ * @return 
+ *         Current time in microseconds.
+ *
+ * @pre Timer module was previously enabled.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_Now64 ( void )
+{
+#if ( TIMER_RP2040_DEBUG != 0 )
+  uint64 time = 0;
+
+  if( TIMER_RP2040_INIT == Timer_RP2040_IsInit() )
+  {
+    time = Timer_RP2040_TimerRead64();
+  }
+
+  return time;
+#else
+  return Timer_RP2040_RawNow64();
+#endif
+}
+
+/**
+ * Microseconds elapsed since 'start', a previous Timer_RP2040_Now32 value. Unsigned subtraction keeps the result
+ * correct across the 32 bit wrap, for intervals up to 2^32 - 1 microseconds (about 71 minutes).
+ * @param start: Earlier Timer_RP2040_Now32 reading.
+ *
+ * @return 
+ *         Elapsed time in microseconds.
+ *
+ * @pre Timer module was previously enabled.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_Elapsed32 ( uint32 start )
+{
+  return (uint32)(Timer_RP2040_Now32() - start);
+}
+
+#endif /* TIMER_RP2040_H */
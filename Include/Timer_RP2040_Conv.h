@@ -0,0 +1,263 @@
+/**
+ *
+* @file "Timer_RP2040_Conv.h"
+* @author Madrick3
+* @brief Time unit conversions (us, ms, s, min) without calls to the libgcc division routines - the Cortex-M0+ has no
+* divide instruction, and a 64 bit division in software costs hundreds of cycles.
+*
+* The divisors are compile-time constants, so each 32 bit division is a multiplication by a rounded-up reciprocal
+* followed by a shift. The reciprocals are exact for every 32 bit input: with m = ceil(2^k / d), floor(x * m / 2^k)
+* equals floor(x / d) for all x < 2^32 as long as m * d - 2^k <= 2^(k - 32), which holds for each constant below.
+* With TIMER_RP2040_CONV_HWDIV set, the 32 bit divisions use the SIO hardware divider of the calling core instead.
+* The virtual target has no divider and always uses plain C division for that backend.
+*
+* 64 bit microsecond values (Timer_RP2040_Now64) are divided in 16 bit limbs, so the partial dividends stay below
+* 2^32 and the same 32 bit fast path applies. Variable divisors (Timer_RP2040_UDiv64) use binary long division.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.03.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-015   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-017   |  Divisor 10 for decimal output
+  01.03.00 |  Madrick3 |  user-017   |  64 by 32 bit division for a variable divisor
+************************************************************/
+#if !defined( TIMER_RP2040_CONV_H )
+#define TIMER_RP2040_CONV_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Set to 1 to divide with the SIO hardware divider instead of the reciprocals */
+#if !defined( TIMER_RP2040_CONV_HWDIV )
+#define TIMER_RP2040_CONV_HWDIV 0
+#endif
+
+/* Reciprocals m = ceil(2^shift / divisor) */
+#define TIMER_RP2040_CONV_RECIP_10         0xCCCCCCCDuL
+#define TIMER_RP2040_CONV_SHIFT_10         35
+#define TIMER_RP2040_CONV_RECIP_60         0x88888889uL
+#define TIMER_RP2040_CONV_SHIFT_60         37
+#define TIMER_RP2040_CONV_RECIP_1000       0x10624DD3uL
+#define TIMER_RP2040_CONV_SHIFT_1000       38
+#define TIMER_RP2040_CONV_RECIP_1000000    0x431BDE83uL
+#define TIMER_RP2040_CONV_SHIFT_1000000    50
+
+/* floor(value / divisor) of a 32 bit value, by reciprocal multiplication or by the selected divider */
+#if ( TIMER_RP2040_CONV_HWDIV != 0 )
+#define TIMER_RP2040_CONV_DIV(value, divisor, recip, shift) Timer_RP2040_UDiv32((value), (divisor))
+#else
+#define TIMER_RP2040_CONV_DIV(value, divisor, recip, shift) \
+  ((uint32)(((uint64)(uint32)(value) * (recip)) >> (shift)))
+#endif
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Converts 64 bit microseconds to milliseconds, rounding down.
+ * @param us: Microseconds, for example from Timer_RP2040_Now64.
+ *
+ * @return 
+ *         Milliseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_Us64ToMs ( uint64 us );
+
+/**
+ * Converts 64 bit microseconds to seconds, rounding down.
+ * @param us: Microseconds, for example from Timer_RP2040_Now64.
+ *
+ * @return 
+ *         Seconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_Us64ToS ( uint64 us );
+
+/**
+ * Unsigned 64 by 32 bit division for a divisor that is not known at compile time, for example a sample count.
+ * @param dividend: Value to divide.
+ * @param divisor: Non-zero divisor.
+ *
+ * @return 
+ *         floor(dividend / divisor).
+ *
+ * @pre divisor != 0
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_UDiv64 ( uint64 dividend, uint32 divisor );
+
+/************************************************************
+  INLINE FUNCTIONS
+************************************************************/
+
+/**
+ * Unsigned 32 bit division. Uses the SIO hardware divider with TIMER_RP2040_CONV_HWDIV on the RP2040, C division
+ * otherwise.
+ * @param dividend: Value to divide.
+ * @param divisor: Non-zero divisor.
+ *
+ * @return 
+ *         floor(dividend / divisor).
+ *
+ * @pre With TIMER_RP2040_CONV_HWDIV, no interrupt that uses the divider of this core may preempt the call (or it
+ *      saves and restores the divider state).
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_UDiv32 ( uint32 dividend, uint32 divisor )
+{
+#if ( TIMER_RP2040_CONV_HWDIV != 0 ) && !defined( VIRTUAL_TARGET )
+  TIMER_REG_WRITE(SIO_REG_DIV_UDIVIDEND, dividend);
+  TIMER_REG_WRITE(SIO_REG_DIV_UDIVISOR, divisor);
+  while( ZERO32 == (TIMER_REG_READ(SIO_REG_DIV_CSR) & SIO_DIV_CSR_READY_MASK) )
+  {
+  }
+
+  return TIMER_REG_READ(SIO_REG_DIV_QUOTIENT);
+#else
+  return dividend / divisor;
+#endif
+}
+
+/**
+ * Converts microseconds to milliseconds, rounding down.
+ * @param us: Microseconds.
+ *
+ * @return 
+ *         Milliseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_UsToMs ( uint32 us )
+{
+  return TIMER_RP2040_CONV_DIV(us, 1000uL, TIMER_RP2040_CONV_RECIP_1000, TIMER_RP2040_CONV_SHIFT_1000);
+}
+
+/**
+ * Converts microseconds to seconds, rounding down.
+ * @param us: Microseconds.
+ *
+ * @return 
+ *         Seconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_UsToS ( uint32 us )
+{
+  return TIMER_RP2040_CONV_DIV(us, 1000000uL, TIMER_RP2040_CONV_RECIP_1000000, TIMER_RP2040_CONV_SHIFT_1000000);
+}
+
+/**
+ * Converts milliseconds to seconds, rounding down.
+ * @param ms: Milliseconds.
+ *
+ * @return 
+ *         Seconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_MsToS ( uint32 ms )
+{
+  return TIMER_RP2040_CONV_DIV(ms, 1000uL, TIMER_RP2040_CONV_RECIP_1000, TIMER_RP2040_CONV_SHIFT_1000);
+}
+
+/**
+ * Converts seconds to minutes, rounding down.
+ * @param s: Seconds.
+ *
+ * @return 
+ *         Minutes.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_SToMin ( uint32 s )
+{
+  return TIMER_RP2040_CONV_DIV(s, 60uL, TIMER_RP2040_CONV_RECIP_60, TIMER_RP2040_CONV_SHIFT_60);
+}
+
+/**
+ * Converts milliseconds to microseconds. The result cannot overflow.
+ * @param ms: Milliseconds.
+ *
+ * @return 
+ *         Microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_MsToUs ( uint32 ms )
+{
+  return (uint64)ms * 1000uL;
+}
+
+/**
+ * Converts seconds to milliseconds. The result cannot overflow.
+ * @param s: Seconds.
+ *
+ * @return 
+ *         Milliseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_SToMs ( uint32 s )
+{
+  return (uint64)s * 1000uL;
+}
+
+/**
+ * Converts minutes to seconds. The result cannot overflow.
+ * @param min: Minutes.
+ *
+ * @return 
+ *         Seconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_MinToS ( uint32 min )
+{
+  return (uint64)min * 60uL;
+}
+
+#endif /* TIMER_RP2040_CONV_H */
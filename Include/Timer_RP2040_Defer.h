@@ -0,0 +1,139 @@
+/**
+ *
+* @file "Timer_RP2040_Defer.h"
+* @author Madrick3
+* @brief Deferred work queue for the RP2040 timer. Timer callbacks running in interrupt context post a function and
+* context pointer, and the main loop (or the other core) runs them later with Timer_RP2040_DeferProcess.
+*
+* The queue is a fixed capacity single-producer / single-consumer ring. It uses no locks and does not mask interrupts:
+* the producer only ever writes the tail index and the consumer only ever writes the head index. Exactly one context
+* may post (for example the TIMER_IRQ) and exactly one context may consume.
+*
+* Every entry carries the TIMERAWL time at which it was posted, so consumers can measure the queueing delay.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-006   |  Initial Creation
+************************************************************/
+#if !defined( TIMER_RP2040_DEFER_H )
+#define TIMER_RP2040_DEFER_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Number of entries in the ring, must be a power of two. May be overriden by the build. */
+#if !defined( TIMER_RP2040_DEFER_CAPACITY )
+#define TIMER_RP2040_DEFER_CAPACITY 32uL
+#endif
+
+#define TIMER_RP2040_DEFER_MASK (TIMER_RP2040_DEFER_CAPACITY - 1uL)
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Deferred function - 'timestamp' is the low 32 bits of the time at which the work was posted. */
+typedef void (*tTimer_RP2040_DeferFunction)( void * context, uint32 timestamp );
+
+/* One queued piece of work */
+typedef struct Timer_RP2040_DeferEntry_Tag {
+  tTimer_RP2040_DeferFunction function;
+  void * context;
+  /* TIMERAWL when the entry was posted */
+  uint32 timestamp;
+} tTimer_RP2040_DeferEntry;
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the deferred work queue, dropping any queued entries. Must not run concurrently with the producer or
+ * the consumer.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The queue is empty.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DeferInit ( void );
+
+/**
+ * Queues 'function' to be called with 'context' by the consumer. Producer side - may be called from the TIMER_IRQ.
+ * @param function: Function to run, may not be NULL.
+ * @param context: Passed to the function untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the queue is full - the entry is dropped and counted
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the queue is not yet initialized
+ *
+ * @pre Queue was previously initialized.
+ * @post The entry is visible to the consumer.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DeferPost ( tTimer_RP2040_DeferFunction function, void * context );
+
+/**
+ * Removes the oldest entry from the queue without running it. Consumer side.
+ * @param entry: Receives the oldest entry.
+ *
+ * @return
+ *         0: 'E_OK' if an entry was removed
+ *         1: 'E_NOT_OK' if the queue is empty
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the queue is not yet initialized
+ *
+ * @pre Queue was previously initialized.
+ * @post The slot is free for the producer.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DeferPop ( tTimer_RP2040_DeferEntry * entry );
+
+/**
+ * Runs queued entries, oldest first, until the queue is empty or 'maxEntries' have run. Consumer side - intended for
+ * the main loop or the other core.
+ * @param maxEntries: Upper bound on the number of entries run in this call.
+ *
+ * @return
+ *         Number of entries run.
+ *
+ * @pre Queue was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_DeferProcess ( uint32 maxEntries );
+
+/**
+ * Reports the number of entries dropped by Timer_RP2040_DeferPost because the queue was full.
+ *
+ * @return
+ *         Dropped entries since Timer_RP2040_DeferInit.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_DeferDropped ( void );
+
+#endif /* TIMER_RP2040_DEFER_H */
@@ -0,0 +1,126 @@
+/**
+ *
+* @file "Timer_RP2040_Delay.h"
+* @author Madrick3
+* @brief Blocking delays on the free running timer. Timer_RP2040_DelayUs waits a number of microseconds,
+* Timer_RP2040_DelayUntil waits for an absolute TIMERAWL value.
+*
+* Short delays spin on TIMERAWL with a wrap-safe compare. The counter ticks once per microsecond from the watchdog
+* reference, so the spin needs no calibration against the CPU clock and a 1us delay is as exact as a 10ms one.
+* Delays longer than TIMER_RP2040_DELAY_SLEEP_US sleep instead, once Timer_RP2040_DelayInit has reserved
+* TIMER_RP2040_DELAY_ALARM: the alarm is armed TIMER_RP2040_DELAY_WAKE_US before the deadline, the core waits for
+* events until then, and the remainder is spun so that the wake-up latency does not lengthen the delay. Without
+* Timer_RP2040_DelayInit every delay spins.
+*
+* The sleep is a WFE on the RP2040. The host build steps the simulator to its next comparator match instead, and the
+* spin advances the simulated time by 1us per poll. Both may be replaced by the build, e.g. with an RTOS yield.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-024   |  Initial Creation
+************************************************************/
+#if !defined( TIMER_RP2040_DELAY_H )
+#define TIMER_RP2040_DELAY_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Alarm reserved by Timer_RP2040_DelayInit for sleeping delays. May be overriden by the build. */
+#if !defined( TIMER_RP2040_DELAY_ALARM )
+#define TIMER_RP2040_DELAY_ALARM ALARM3_INDEX
+#endif
+
+/* Delays longer than this sleep, shorter ones spin. May be overriden by the build. */
+#if !defined( TIMER_RP2040_DELAY_SLEEP_US )
+#define TIMER_RP2040_DELAY_SLEEP_US 50uL
+#endif
+
+/* Wake-up margin: a sleeping delay wakes this long before its deadline and spins the rest. Below the threshold. */
+#if !defined( TIMER_RP2040_DELAY_WAKE_US )
+#define TIMER_RP2040_DELAY_WAKE_US 5uL
+#endif
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+#include "Timer_RP2040_Sim.h"
+
+/*
+  Waiting primitives of the delay loops. TIMER_RP2040_DELAY_SLEEP waits for the next event - the delay alarm is armed,
+  so one arrives by the wake time at the latest. TIMER_RP2040_DELAY_SPIN runs once per poll of TIMERAWL.
+*/
+#if !defined( TIMER_RP2040_DELAY_SLEEP )
+#if !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_DELAY_SLEEP() __asm__ __volatile__ ( "wfe" : : : "memory" )
+#else
+#define TIMER_RP2040_DELAY_SLEEP() ((void)Timer_RP2040_SimStep())
+#endif
+#endif
+
+#if !defined( TIMER_RP2040_DELAY_SPIN )
+#if !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_DELAY_SPIN()
+#else
+#define TIMER_RP2040_DELAY_SPIN() ((void)Timer_RP2040_SimAdvance(1))
+#endif
+#endif
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Reserves TIMER_RP2040_DELAY_ALARM for sleeping delays: registers the callback that acknowledges its interrupt and
+ * enables the interrupt. Replaces any callback registered for the alarm.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled. The TIMER_IRQ of the delay alarm is routed to Timer_RP2040_IrqHandler.
+ * @post Delays longer than TIMER_RP2040_DELAY_SLEEP_US sleep.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DelayInit ( void );
+
+/**
+ * Waits 'delay' microseconds, counted from the call.
+ * @param delay: Microseconds to wait, must be below TIMER_RP2040_HALF_RANGE32. 0 returns at once.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre The timer is not paused. Sleeping delays are used from thread mode on one core at a time - from interrupts
+ *      and the other core, keep delays at or below TIMER_RP2040_DELAY_SLEEP_US.
+ * @post At least 'delay' microseconds have passed.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DelayUs ( uint32 delay );
+
+/**
+ * Waits until TIMERAWL reaches 'deadline'. A deadline up to 2^31 us in the past is treated as passed.
+ * @param deadline: Absolute 32 bit time, e.g. Timer_RP2040_Now32() + period for a drift free loop.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre As for Timer_RP2040_DelayUs.
+ * @post The deadline has passed.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_DelayUntil ( uint32 deadline );
+
+#endif /* TIMER_RP2040_DELAY_H */
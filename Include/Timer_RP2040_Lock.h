@@ -0,0 +1,154 @@
+/**
+ *
+* @file "Timer_RP2040_Lock.h"
+* @author Madrick3
+* @brief Lock abstraction for the RP2040 timer component. With TIMER_RP2040_MULTICORE set, the multi-write register
+* sequences (alarm arm/disarm), the IRQ callback table and the scheduler state are guarded so that both Cortex-M0+
+* cores (and their interrupts) may use the component at the same time. Single bit updates of INTE, INTF and INTR
+* use the atomic register aliases instead and need no lock:
+*   - RP2040: interrupts are masked on the calling core (PRIMASK) and an SIO hardware spinlock is claimed. The
+*     uncontended cost is a handful of instructions and a single spinlock read.
+*   - VIRTUAL_TARGET: an atomic test-and-set flag per lock, so that the host tests can run the driver from several
+*     threads.
+* Without TIMER_RP2040_MULTICORE there is no other core to exclude, but the driver state (parked and forced bitmaps,
+* 64 bit deadlines) is still shared between thread mode and Timer_RP2040_IrqHandler, so the locks mask interrupts on
+* the RP2040 (PRIMASK is saved in 'state' and restored on release). The single threaded host build compiles them to
+* nothing. An integration may provide its own TIMER_RP2040_LOCK and TIMER_RP2040_UNLOCK instead (for example to share
+* an RTOS critical section).
+*
+* Included through Timer_RP2040.h. Locks do not nest recursively. The scheduler lock may be held while taking the
+* driver lock, never the other way around. The trace lock is a leaf - nothing is taken while holding it.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.03.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-007   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-016   |  Trace lock
+  01.03.00 |  Madrick3 |  user-011   |  Single core locks mask interrupts
+************************************************************/
+#if !defined( TIMER_RP2040_LOCK_H )
+#define TIMER_RP2040_LOCK_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Set to 1 when the timer component is used from both cores */
+#if !defined( TIMER_RP2040_MULTICORE )
+#define TIMER_RP2040_MULTICORE 0
+#endif
+
+/* Logical locks of the component */
+#define TIMER_RP2040_LOCK_DRIVER 0
+#define TIMER_RP2040_LOCK_SCHED  1
+#define TIMER_RP2040_LOCK_TRACE  2
+#define TIMER_RP2040_LOCK_COUNT  3
+
+/* First SIO spinlock used by the component - one spinlock per logical lock. Lower spinlocks are often SDK owned. */
+#if !defined( TIMER_RP2040_SPINLOCK_BASE )
+#define TIMER_RP2040_SPINLOCK_BASE 24
+#endif
+
+/*
+  TIMER_RP2040_LOCK(lock, state) claims 'lock' and stores what is needed to release it in the uint32 'state'.
+  TIMER_RP2040_UNLOCK(lock, state) releases it again.
+*/
+#if !defined( TIMER_RP2040_LOCK )
+#if ( TIMER_RP2040_MULTICORE != 0 )
+#define TIMER_RP2040_LOCK(lock, state)   ((state) = Timer_RP2040_LockAcquire(lock))
+#define TIMER_RP2040_UNLOCK(lock, state) Timer_RP2040_LockRelease((lock), (state))
+#elif !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_LOCK(lock, state) \
+  __asm__ __volatile__ ( "mrs %0, primask\n\tcpsid i" : "=r" (state) : : "memory" )
+#define TIMER_RP2040_UNLOCK(lock, state) __asm__ __volatile__ ( "msr primask, %0" : : "r" (state) : "memory" )
+#else
+#define TIMER_RP2040_LOCK(lock, state)   ((state) = ZERO32)
+#define TIMER_RP2040_UNLOCK(lock, state) ((void)(state))
+#endif
+#endif
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Platform_Types.h"
+#include "Timer_RP2040_SFR.h"
+
+/************************************************************
+  EXTERN VARIABLES
+************************************************************/
+#if ( TIMER_RP2040_MULTICORE != 0 ) && defined( VIRTUAL_TARGET )
+/* Host stand-in for the SIO spinlocks, owned by Timer_RP2040.c */
+extern volatile uint32 Timer_RP2040_LockWord[TIMER_RP2040_LOCK_COUNT];
+#endif
+
+/************************************************************
+  INLINE FUNCTIONS
+************************************************************/
+#if ( TIMER_RP2040_MULTICORE != 0 )
+
+/**
+ * Claims a component lock, masking interrupts on the calling core first so that the holder cannot be preempted by
+ * an interrupt that wants the same lock.
+ * @param lock: Logical lock, one of TIMER_RP2040_LOCK_DRIVER, _SCHED or _TRACE.
+ *
+ * @return
+ *         Interrupt state to restore on release.
+ *
+ * @pre The calling core does not hold 'lock'.
+ * @post The calling core holds 'lock'.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_LockAcquire ( uint32 lock )
+{
+#if defined( VIRTUAL_TARGET )
+  while( ZERO32 != __sync_lock_test_and_set(&Timer_RP2040_LockWord[lock], 1uL) )
+  {
+  }
+
+  return ZERO32;
+#else
+  uint32 state;
+
+  __asm__ __volatile__ ( "mrs %0, primask\n\tcpsid i" : "=r" (state) : : "memory" );
+  while( ZERO32 == TIMER_REG_READ(SIO_REG_SPINLOCKn(TIMER_RP2040_SPINLOCK_BASE + lock)) )
+  {
+  }
+  TIMER_RP2040_MEMORY_BARRIER();
+
+  return state;
+#endif
+}
+
+/**
+ * Releases a component lock and restores the interrupt state saved by Timer_RP2040_LockAcquire.
+ * @param lock: Logical lock, one of TIMER_RP2040_LOCK_DRIVER, _SCHED or _TRACE.
+ * @param state: Value returned by the matching Timer_RP2040_LockAcquire.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre The calling core holds 'lock'.
+ * @post 'lock' is free.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE void Timer_RP2040_LockRelease ( uint32 lock, uint32 state )
+{
+#if defined( VIRTUAL_TARGET )
+  (void)state;
+  __sync_lock_release(&Timer_RP2040_LockWord[lock]);
+#else
+  TIMER_RP2040_MEMORY_BARRIER();
+  TIMER_REG_WRITE(SIO_REG_SPINLOCKn(TIMER_RP2040_SPINLOCK_BASE + lock), ZERO32);
+  __asm__ __volatile__ ( "msr primask, %0" : : "r" (state) : "memory" );
+#endif
+}
+
+#endif /* TIMER_RP2040_MULTICORE */
+
+#endif /* TIMER_RP2040_LOCK_H */
@@ -0,0 +1,203 @@
+/**
+ *
+* @file "Timer_RP2040_Prof.h"
+* @author Madrick3
+* @brief Code section profiling on the free running timer. A section is bracketed by Timer_RP2040_ProfBegin and
+* Timer_RP2040_ProfEnd with a site id chosen by the application (usually a #define), and each site accumulates the
+* call count, total, minimum and maximum duration in microseconds.
+*
+* The markers are inline: Begin is a TIMERAWL load and a store, End a load, a wrap-safe subtraction and the updates
+* of the accumulators. Sections may span a wrap of the 32 bit timer but must be shorter than 2^32 us. A site must
+* only be used from one context at a time - an interrupt that profiles the same site as the code it preempts
+* overwrites its start time. With TIMER_RP2040_PROF set to 0 the markers compile to nothing.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-017   |  Initial Creation
+************************************************************/
+#if !defined( TIMER_RP2040_PROF_H )
+#define TIMER_RP2040_PROF_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Set to 0 to compile the profiling markers out */
+#if !defined( TIMER_RP2040_PROF )
+#define TIMER_RP2040_PROF 1
+#endif
+
+/* Number of profiling sites. May be overriden by the build. */
+#if !defined( TIMER_RP2040_PROF_SITES )
+#define TIMER_RP2040_PROF_SITES 16u
+#endif
+
+/* Longest line passed to the Timer_RP2040_ProfDump output function, including the terminating zero */
+#define TIMER_RP2040_PROF_LINE_MAX 72u
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Accumulators of one site - written by the markers only */
+typedef struct Timer_RP2040_ProfSite_Tag {
+  /* TIMERAWL at the last Timer_RP2040_ProfBegin */
+  uint32 start;
+  uint32 count;
+  uint32 min;
+  uint32 max;
+  uint64 total;
+} tTimer_RP2040_ProfSite;
+
+/* Statistics of one site, see Timer_RP2040_ProfRead. All times in microseconds. */
+typedef struct Timer_RP2040_ProfStats_Tag {
+  uint32 count;
+  uint32 min;
+  uint32 max;
+  uint32 mean;
+  uint64 total;
+} tTimer_RP2040_ProfStats;
+
+/* Receives one zero terminated line of the Timer_RP2040_ProfDump table */
+typedef void (*tTimer_RP2040_ProfOutput)( const char * line );
+
+/************************************************************
+  EXTERN VARIABLES
+************************************************************/
+
+/* Site accumulators, owned by Timer_RP2040_Prof.c - global only so that the markers can be inlined */
+extern tTimer_RP2040_ProfSite Timer_RP2040_ProfSite[TIMER_RP2040_PROF_SITES];
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Clears the accumulators of every site.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled. No section is being profiled.
+ * @post Every site reports a count of 0.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ProfInit ( void );
+
+/**
+ * Reads the statistics of one site.
+ * @param site: Site id, must be below TIMER_RP2040_PROF_SITES.
+ * @param stats: Receives the statistics - min, max and mean are 0 while the count is 0.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *
+ * @pre Profiling was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ProfRead ( uint8 site, tTimer_RP2040_ProfStats * stats );
+
+/**
+ * Writes the statistics of every site with a non-zero count as a table, one line per call of 'output':
+ *   site      count        total_us    min_us    max_us   mean_us
+ * Numbers are formatted without the C library, so the dump also works on targets without printf.
+ * @param output: Receives each line, may not be NULL.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *
+ * @pre Profiling was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_ProfDump ( tTimer_RP2040_ProfOutput output );
+
+/************************************************************
+  INLINE FUNCTIONS
+************************************************************/
+
+/**
+ * Starts a profiled section.
+ * @param site: Site id, must be below TIMER_RP2040_PROF_SITES. Not checked in release builds.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Profiling was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE void Timer_RP2040_ProfBegin ( uint8 site )
+{
+#if ( TIMER_RP2040_PROF != 0 )
+#if ( TIMER_RP2040_DEBUG != 0 )
+  if( site < TIMER_RP2040_PROF_SITES )
+#endif
+  {
+    Timer_RP2040_ProfSite[site].start = Timer_RP2040_Now32();
+  }
+#else
+  (void)site;
+#endif
+}
+
+/**
+ * Ends a profiled section and accumulates its duration.
+ * @param site: Site id of the matching Timer_RP2040_ProfBegin. Not checked in release builds.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Timer_RP2040_ProfBegin was called for 'site' from the same context.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE void Timer_RP2040_ProfEnd ( uint8 site )
+{
+#if ( TIMER_RP2040_PROF != 0 )
+  tTimer_RP2040_ProfSite * entry;
+  uint32 elapsed;
+
+#if ( TIMER_RP2040_DEBUG != 0 )
+  if( site < TIMER_RP2040_PROF_SITES )
+#endif
+  {
+    entry = &Timer_RP2040_ProfSite[site];
+    elapsed = Timer_RP2040_Now32() - entry->start;
+
+    entry->count++;
+    entry->total += elapsed;
+    if( elapsed < entry->min )
+    {
+      entry->min = elapsed;
+    }
+    if( elapsed > entry->max )
+    {
+      entry->max = elapsed;
+    }
+  }
+#else
+  (void)site;
+#endif
+}
+
+#endif /* TIMER_RP2040_PROF_H */
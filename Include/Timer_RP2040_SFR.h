@@ -20,6 +20,8 @@
   01.00.00 |  Madrick3 |  draft     |  Initial Creation.
   01.01.00 |  Madrick3 |  skeleton  |  Integration for initial testing
 ************************************************************/
+#if !defined( TIMER_RP2040_SFR_H )
+#define TIMER_RP2040_SFR_H
 
 /************************************************************
   INCLUDES
@@ -60,6 +62,8 @@ typedef struct vtt_RP2040_Timer
   uint32 INTF;
   uint32 INTS;
 } tRP2040_Timer;
+/* Register model of the virtual target, owned by Timer_RP2040.c */
+extern volatile tRP2040_Timer Timer_Live;
 /* Virtual Target has 64 bit word size and must be casted as such to accomodate virtual access */
 #define TIMER_BASE (uint64)&Timer_Live
 #endif /* VIRTUAL_TARGET */
@@ -106,6 +110,86 @@ typedef struct vtt_RP2040_Timer
 #define TIMER_REG_INTF                  SFR_IOS(TIMER_BASE + TIMER_REG_INTF_OFFSET)
 #define TIMER_REG_INTS                  SFR_IOS(TIMER_BASE + TIMER_REG_INTS_OFFSET)
 
+/*
+  Register access probe for the host benchmark. With TIMER_RP2040_REG_PROBE set on the virtual target, every register
+  access made through the macros below is counted in Timer_RP2040_RegAccessCount.
+*/
+#if !defined( TIMER_RP2040_REG_PROBE )
+#define TIMER_RP2040_REG_PROBE 0
+#endif
+
+#if ( TIMER_RP2040_REG_PROBE != 0 ) && defined( VIRTUAL_TARGET )
+extern uint32 Timer_RP2040_RegAccessCount;
+#define TIMER_REG_PROBE()               (Timer_RP2040_RegAccessCount++)
+#else
+#define TIMER_REG_PROBE()               ((void)0)
+#endif
+
+/*
+  Single 32 bit volatile load / store of a register. SFR_IOS is 64 bits wide on the virtual target, so plain dereferences
+  would read the neighbouring register as well - and without volatile the compiler may merge repeated reads.
+*/
+#define TIMER_REG_PTR(reg)              ((volatile uint32 *)(reg))
+#define TIMER_REG_READ(reg)             (TIMER_REG_PROBE(), *TIMER_REG_PTR(reg))
+#define TIMER_REG_WRITE(reg, value)     (TIMER_REG_PROBE(), *TIMER_REG_PTR(reg) = (uint32)(value))
+
+/*
+  Atomic register aliases (RP2040 datasheet 2.1.2). A write to the alias address of a register sets, clears or
+  toggles exactly the bits written, in a single bus transaction and without a read - so no lock is needed against
+  the other core or an interrupt. Write-clear registers (INTR, ARMED) need no alias: writing 1 clears the bit.
+  The virtual target has no alias addresses, so the same effect is emulated with an atomic read-modify-write on the
+  register model.
+*/
+#define REG_ALIAS_XOR_OFFSET            0x1000uL
+#define REG_ALIAS_SET_OFFSET            0x2000uL
+#define REG_ALIAS_CLR_OFFSET            0x3000uL
+
+#if !defined( VIRTUAL_TARGET )
+#define TIMER_REG_ALIAS(reg, offset)    ((volatile uint32 *)((uint32)(reg) + (offset)))
+#define TIMER_REG_SET(reg, bits)        (*TIMER_REG_ALIAS((reg), REG_ALIAS_SET_OFFSET) = (uint32)(bits))
+#define TIMER_REG_CLR(reg, bits)        (*TIMER_REG_ALIAS((reg), REG_ALIAS_CLR_OFFSET) = (uint32)(bits))
+#define TIMER_REG_XOR(reg, bits)        (*TIMER_REG_ALIAS((reg), REG_ALIAS_XOR_OFFSET) = (uint32)(bits))
+#define TIMER_REG_W1C(reg, bits)        TIMER_REG_WRITE((reg), (bits))
+#else /* VIRTUAL_TARGET */
+#define TIMER_REG_SET(reg, bits)        (TIMER_REG_PROBE(), (void)__sync_fetch_and_or(TIMER_REG_PTR(reg), (uint32)(bits)))
+#define TIMER_REG_CLR(reg, bits)        (TIMER_REG_PROBE(), (void)__sync_fetch_and_and(TIMER_REG_PTR(reg), ~(uint32)(bits)))
+#define TIMER_REG_XOR(reg, bits)        (TIMER_REG_PROBE(), (void)__sync_fetch_and_xor(TIMER_REG_PTR(reg), (uint32)(bits)))
+#define TIMER_REG_W1C(reg, bits)        (TIMER_REG_PROBE(), (void)__sync_fetch_and_and(TIMER_REG_PTR(reg), ~(uint32)(bits)))
+#endif /* VIRTUAL_TARGET */
+
+/*
+  Writing ALARMn also arms the alarm, the hardware sets its ARMED bit. The virtual target models that side effect, so
+  that the simulator (Timer_RP2040_Sim.h) sees the alarm armed.
+*/
+#if !defined( VIRTUAL_TARGET )
+#define TIMER_REG_ALARM_WRITE(n, value) TIMER_REG_WRITE(TIMER_REG_ALARMn(n), (value))
+#else /* VIRTUAL_TARGET */
+#define TIMER_REG_ALARM_WRITE(n, value) (TIMER_REG_WRITE(TIMER_REG_ALARMn(n), (value)), \
+                                         (void)__sync_fetch_and_or(TIMER_REG_PTR(TIMER_REG_ARMED), (1uL << (n))))
+#endif /* VIRTUAL_TARGET */
+
+/* SIO hardware spinlocks - reading claims the lock (non-zero if successful), writing any value releases it. */
+#define SIO_BASE                        0xD0000000uL
+#define SIO_SPINLOCK0_OFFSET            0x100uL
+#define SIO_SPINLOCKn_OFFSET(n)         (SIO_SPINLOCK0_OFFSET + ((uint32)(n) * 4uL))
+#define SIO_REG_SPINLOCKn(n)            SFR_IOS(SIO_BASE + SIO_SPINLOCKn_OFFSET(n))
+
+/*
+  SIO integer divider of the calling core. Writing the divisor starts an unsigned division, the result is valid once
+  CSR.READY is set (8 cycles). Reading the quotient clears CSR.DIRTY.
+*/
+#define SIO_DIV_UDIVIDEND_OFFSET        0x060uL
+#define SIO_DIV_UDIVISOR_OFFSET         0x064uL
+#define SIO_DIV_QUOTIENT_OFFSET         0x070uL
+#define SIO_DIV_REMAINDER_OFFSET        0x074uL
+#define SIO_DIV_CSR_OFFSET              0x078uL
+#define SIO_REG_DIV_UDIVIDEND           SFR_IOS(SIO_BASE + SIO_DIV_UDIVIDEND_OFFSET)
+#define SIO_REG_DIV_UDIVISOR            SFR_IOS(SIO_BASE + SIO_DIV_UDIVISOR_OFFSET)
+#define SIO_REG_DIV_QUOTIENT            SFR_IOS(SIO_BASE + SIO_DIV_QUOTIENT_OFFSET)
+#define SIO_REG_DIV_REMAINDER           SFR_IOS(SIO_BASE + SIO_DIV_REMAINDER_OFFSET)
+#define SIO_REG_DIV_CSR                 SFR_IOS(SIO_BASE + SIO_DIV_CSR_OFFSET)
+#define SIO_DIV_CSR_READY_MASK          0x00000001uL
+
 /* Set high to pause the timer - low to unpause. */
 #define TIMER_PAUSE_MASK                0x00000001
 #define TIMER_PAUSE_SET                 0x00000001
@@ -123,3 +207,4 @@ typedef struct vtt_RP2040_Timer
   GLOBAL FUNCTIONS
 ************************************************************/
 
+#endif /* TIMER_RP2040_SFR_H */
@@ -0,0 +1,335 @@
+/**
+ *
+* @file "Timer_RP2040_Sched.h"
+* @author Madrick3
+* @brief Software alarm multiplexer for the RP2040 timer. Any number of logical (soft) timers may be started on top of
+* a single hardware alarm, TIMER_RP2040_SCHED_ALARM_INDEX. The backend is selected at build time:
+*   - TIMER_RP2040_SCHED_BACKEND_HEAP (default): the soft timers are kept in a deadline ordered min-heap, and only the
+*     earliest deadline is ever programmed into the hardware alarm. Insert, cancel and expire all take O(log n) time,
+*     so a large number of pending timers does not cost more interrupt time than a handful.
+*   - TIMER_RP2040_SCHED_BACKEND_WHEEL: the soft timers are hashed into a hierarchical timing wheel which is driven by
+*     a periodic TIMER_RP2040_SCHED_TICK_US tick on the hardware alarm. Insert and cancel are O(1), upper wheel levels
+*     are cascaded down at their tick boundaries. Expiry is rounded up to the next tick. With TIMER_RP2040_TICKLESS
+*     the alarm is only programmed for ticks that have work, and skipped ticks are caught up on wake-up.
+*
+* A soft timer may carry a slack: started with Timer_RP2040_SchedStartWindow it may fire anywhere between its deadline
+* and its deadline plus the slack. Timers whose windows overlap are expired together on a single scheduler alarm
+* interrupt - the heap backend wakes at the end of the earliest closing window and expires every timer whose window has
+* opened by then, the wheel backend moves each timer to the tick with the most trailing zero bits within its window, so
+* that loose timers converge on the same ticks. Timer_RP2040_SchedCoalesceStats reports the interrupts saved.
+*
+* For tickless idle, Timer_RP2040_SchedTimeToNext reports how long the system may sleep, and
+* Timer_RP2040_SchedCatchUpTicks derives the logical tick count from the 64 bit timer after waking.
+*
+* Soft timer storage is owned by the caller - the scheduler only keeps pointers, so no dynamic memory is required.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.06.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-001   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-002   |  Hierarchical timing wheel backend
+  01.03.00 |  Madrick3 |  user-007   |  Multicore scheduler lock
+  01.04.00 |  Madrick3 |  user-009   |  Tickless idle support
+  01.05.00 |  Madrick3 |  user-019   |  Timer coalescing with slack windows
+  01.06.00 |  Madrick3 |  user-001   |  Single core critical section masks interrupts
+************************************************************/
+#if !defined( TIMER_RP2040_SCHED_H )
+#define TIMER_RP2040_SCHED_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Scheduler backends */
+#define TIMER_RP2040_SCHED_BACKEND_HEAP  1
+#define TIMER_RP2040_SCHED_BACKEND_WHEEL 2
+
+#if !defined( TIMER_RP2040_SCHED_BACKEND )
+#define TIMER_RP2040_SCHED_BACKEND TIMER_RP2040_SCHED_BACKEND_HEAP
+#endif
+
+/* Hardware alarm which is owned by the scheduler. ALARM0 is the system tick alarm prepared in Timer_RP2040_Init. */
+#if !defined( TIMER_RP2040_SCHED_ALARM_INDEX )
+#define TIMER_RP2040_SCHED_ALARM_INDEX ALARM0_INDEX
+#endif
+
+/* Maximum number of soft timers that may be pending at once (HEAP). Sizes the heap, may be overriden by the build. */
+#if !defined( TIMER_RP2040_SCHED_MAX_TIMERS )
+#define TIMER_RP2040_SCHED_MAX_TIMERS 64
+#endif
+
+/*
+  Longest distance the hardware alarm is ever programmed into the future - further deadlines are parked by
+  Timer_RP2040_ArmAlarmAt64.
+*/
+#define TIMER_RP2040_SCHED_MAX_SLEEP_US TIMER_RP2040_ALARM_WINDOW_US
+
+/* Wheel tick period (WHEEL) - matches the 1ms ALARM0 tick prepared in Timer_RP2040_Init. */
+#if !defined( TIMER_RP2040_SCHED_TICK_US )
+#define TIMER_RP2040_SCHED_TICK_US 1000uL
+#endif
+
+/* Wheel geometry (WHEEL) - 4 levels of 64 slots cover 2^24 ticks, about 4.6 hours at 1ms. */
+#define TIMER_RP2040_SCHED_WHEEL_BITS   6
+#define TIMER_RP2040_SCHED_WHEEL_SLOTS  (1uL << TIMER_RP2040_SCHED_WHEEL_BITS)
+#define TIMER_RP2040_SCHED_WHEEL_MASK   (TIMER_RP2040_SCHED_WHEEL_SLOTS - 1uL)
+#define TIMER_RP2040_SCHED_WHEEL_LEVELS 4
+#define TIMER_RP2040_SCHED_WHEEL_RANGE  ((uint64)1 << (TIMER_RP2040_SCHED_WHEEL_BITS * TIMER_RP2040_SCHED_WHEEL_LEVELS))
+
+/* Reported by Timer_RP2040_SchedTimeToNext when no soft timer is pending */
+#define TIMER_RP2040_SCHED_NO_DEADLINE (~(uint64)0)
+
+/* Heap slot of a soft timer which is not pending (HEAP) */
+#define TIMER_RP2040_SCHED_INACTIVE 0x00000000uL
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/*
+  Critical section hooks around the heap and the wheel. The scheduler state is shared between the alarm interrupt and
+  the callers of Start/Stop. With TIMER_RP2040_MULTICORE they take the scheduler lock, otherwise they mask interrupts
+  on the RP2040 (the saved PRIMASK is kept in Timer_RP2040_SchedLockState - the sections do not nest). The single
+  threaded host build needs neither. Integrations may provide their own, for example an RTOS critical section.
+*/
+#if !defined( TIMER_RP2040_SCHED_ENTER_CRITICAL )
+#if ( TIMER_RP2040_MULTICORE != 0 )
+#define TIMER_RP2040_SCHED_ENTER_CRITICAL() TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_SCHED, Timer_RP2040_SchedLockState)
+#define TIMER_RP2040_SCHED_EXIT_CRITICAL()  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_SCHED, Timer_RP2040_SchedLockState)
+#elif !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_SCHED_ENTER_CRITICAL() \
+  __asm__ __volatile__ ( "mrs %0, primask\n\tcpsid i" : "=r" (Timer_RP2040_SchedLockState) : : "memory" )
+#define TIMER_RP2040_SCHED_EXIT_CRITICAL() \
+  __asm__ __volatile__ ( "msr primask, %0" : : "r" (Timer_RP2040_SchedLockState) : "memory" )
+#else
+#define TIMER_RP2040_SCHED_ENTER_CRITICAL()
+#define TIMER_RP2040_SCHED_EXIT_CRITICAL()
+#endif
+#endif
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Callback executed from Timer_RP2040_SchedProcess when a soft timer expires. */
+typedef void (*tTimer_RP2040_SoftTimerCallback)( void * context );
+
+/*
+  A soft timer. Storage is owned by the caller and must stay valid while the timer is pending. Zero initialized
+  storage (e.g. a static variable) is a valid idle timer - timers on the stack must be zeroed before first use.
+*/
+typedef struct Timer_RP2040_SoftTimer_Tag {
+  /* Absolute expiry time in microseconds */
+  uint64 deadline;
+  /* Microseconds after the deadline the timer may be delayed to expire together with others */
+  uint32 slack;
+  tTimer_RP2040_SoftTimerCallback callback;
+  void * context;
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+  /* Position within the scheduler heap plus one - TIMER_RP2040_SCHED_INACTIVE if not pending. */
+  uint32 heapSlot;
+#else
+  /* First wheel tick at or after the deadline */
+  uint64 expiryTick;
+  /* Wheel slot list linkage - 'link' points at whatever points at this timer, NULL if not pending. */
+  struct Timer_RP2040_SoftTimer_Tag * next;
+  struct Timer_RP2040_SoftTimer_Tag ** link;
+#endif
+} tTimer_RP2040_SoftTimer;
+
+/* Coalescing statistics, see Timer_RP2040_SchedCoalesceStats */
+typedef struct Timer_RP2040_SchedStats_Tag {
+  /* Soft timers expired */
+  uint32 expired;
+  /* Scheduler wakes which expired at least one timer */
+  uint32 wakes;
+  /* Wakes saved by expiring timers together - expired minus wakes */
+  uint32 saved;
+  /* Sum of the delays from deadline to expiry, in microseconds - the slack actually used plus interrupt latency */
+  uint64 lateTotal;
+} tTimer_RP2040_SchedStats;
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the soft timer scheduler. Drops every pending soft timer and disarms the scheduler alarm (HEAP) or
+ * starts the tick (WHEEL). Registers Timer_RP2040_SchedProcess with Timer_RP2040_IrqHandler for the scheduler alarm.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post No soft timer is pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedInit ( void );
+
+/**
+ * Starts (or restarts) a soft timer at an absolute deadline. If the timer becomes the earliest pending timer, the
+ * scheduler alarm is reprogrammed.
+ * @param timer: Caller owned soft timer storage.
+ * @param deadline: Absolute expiry time in microseconds.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer (HEAP)
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedStart ( tTimer_RP2040_SoftTimer * timer, uint64 deadline,
+                                               tTimer_RP2040_SoftTimerCallback callback, void * context );
+
+/**
+ * Starts (or restarts) a soft timer which may expire anywhere in the window [deadline, deadline + slack], so that it
+ * can share a scheduler alarm interrupt with other timers. A slack of 0 is Timer_RP2040_SchedStart.
+ * @param timer: Caller owned soft timer storage.
+ * @param deadline: Earliest expiry time in microseconds.
+ * @param slack: Microseconds the expiry may be delayed by.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer (HEAP)
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedStartWindow ( tTimer_RP2040_SoftTimer * timer, uint64 deadline, uint32 slack,
+                                                     tTimer_RP2040_SoftTimerCallback callback, void * context );
+
+/**
+ * Starts (or restarts) a soft timer relative to the current time.
+ * @param timer: Caller owned soft timer storage.
+ * @param delay: Microseconds from now until expiry.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer (HEAP)
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedStartIn ( tTimer_RP2040_SoftTimer * timer, uint32 delay,
+                                                 tTimer_RP2040_SoftTimerCallback callback, void * context );
+
+/**
+ * Cancels a pending soft timer. Cancelling a timer which is not pending is not an error.
+ * @param timer: Soft timer to cancel.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is not pending.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedStop ( tTimer_RP2040_SoftTimer * timer );
+
+/**
+ * Reports if the soft timer is pending.
+ * @param timer: Soft timer to check.
+ *
+ * @return
+ *         0: if the timer is not pending (or NULL).
+ *         1: if the timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint8 Timer_RP2040_SchedIsActive ( const tTimer_RP2040_SoftTimer * timer );
+
+/**
+ * Expires every soft timer that is due, and programs the next wake (HEAP: earliest deadline, WHEEL: next tick) into
+ * the scheduler alarm. Called by Timer_RP2040_IrqHandler for TIMER_RP2040_SCHED_ALARM_INDEX, or may be polled.
+ * Acknowledges the scheduler alarm interrupt.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post The scheduler alarm is armed for the next wake, or disarmed if nothing is pending (HEAP).
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedProcess ( void );
+
+/**
+ * Reports the coalescing statistics gathered since Timer_RP2040_SchedInit.
+ * @param stats: Receives the statistics.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SchedCoalesceStats ( tTimer_RP2040_SchedStats * stats );
+
+/**
+ * Reports the time until the scheduler next has work to do (HEAP: the end of the earliest closing window, WHEEL: the next tick that
+ * expires or cascades a timer). Intended for tickless idle - the system may sleep this long without missing a timer.
+ *
+ * @return
+ *         Microseconds until the next event, 0 if it is already due, or TIMER_RP2040_SCHED_NO_DEADLINE if no timer is
+ *         pending (or the scheduler is not initialized).
+ *
+ * @pre Scheduler was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_SchedTimeToNext ( void );
+
+/**
+ * Catches the logical tick count (TIMER_RP2040_SCHED_TICK_US ticks) up with the 64 bit timer, e.g. to step an RTOS
+ * tick after tickless idle. No tick is lost or counted twice, however long the sleep was.
+ *
+ * @return
+ *         Number of ticks since the previous call (or since Timer_RP2040_SchedInit).
+ *
+ * @pre Scheduler was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_SchedCatchUpTicks ( void );
+
+#endif /* TIMER_RP2040_SCHED_H */
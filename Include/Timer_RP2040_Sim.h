@@ -0,0 +1,175 @@
+/**
+ *
+* @file "Timer_RP2040_Sim.h"
+* @author Madrick3
+* @brief Deterministic discrete-event simulator for the VIRTUAL_TARGET register model. The simulator owns the time
+* of Timer_Live and advances it on request, applying what the timer hardware does on its own:
+*   - TIMERAWH/TIMERAWL count, and TIMEHR/TIMELR hold the latched time of the last step.
+*   - An armed ALARMn matches when the low 32 bits of the time reach its value: the ARMED bit is cleared and the
+*     INTR bit set. An alarm written with the current time matches one 32 bit epoch later, as on the hardware.
+*   - INTS = (INTR | INTF) & INTE. INTR is write-1-to-clear through the driver's register macros.
+*   - Time does not advance while PAUSE is set.
+* Time jumps straight from one comparator match to the next, so hours of simulated 1ms ticks run in a fraction of a
+* second. A registered interrupt handler (usually Timer_RP2040_IrqHandler) is called at every step that leaves INTS
+* non-zero, with the simulated time standing at the match, and called again while INTS stays non-zero - TIMER_IRQ is
+* level sensitive. A handler which never clears it is given up on and reported by Timer_RP2040_SimIrqStorms.
+*
+* Host only - the file compiles to nothing without VIRTUAL_TARGET.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.02.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-012   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-012   |  Level sensitive interrupt delivery
+************************************************************/
+#if !defined( TIMER_RP2040_SIM_H )
+#define TIMER_RP2040_SIM_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Reported by Timer_RP2040_SimNextEvent when no alarm is armed */
+#define TIMER_RP2040_SIM_NO_EVENT (~(uint64)0)
+
+/* Upper bound on handler calls in one step - a handler which leaves an interrupt pending would never return */
+#if !defined( TIMER_RP2040_SIM_MAX_IRQ_NESTING )
+#define TIMER_RP2040_SIM_MAX_IRQ_NESTING 16
+#endif
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+#if defined( VIRTUAL_TARGET )
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Simulated TIMER_IRQ - called while INTS is non-zero */
+typedef void (*tTimer_RP2040_SimIrq)( void );
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Resets the register model to its power-on state at 'time', with no alarm armed and no interrupt handler.
+ * @param time: Simulated time in microseconds.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post Timer_Live holds 'time' in TIMERAWH/TIMERAWL and TIMEHR/TIMELR, every other register is 0.
+ * @invariant n/a
+ *
+ */
+extern void Timer_RP2040_SimReset ( uint64 time );
+
+/**
+ * Installs the simulated TIMER_IRQ handler, or removes it with NULL.
+ * @param handler: Interrupt handler, for example Timer_RP2040_IrqHandler.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern void Timer_RP2040_SimSetIrq ( tTimer_RP2040_SimIrq handler );
+
+/**
+ * Reports interrupt storms: steps at which INTS was still non-zero after TIMER_RP2040_SIM_MAX_IRQ_NESTING handler
+ * calls. On the hardware the handler would have been re-entered forever, so tests expect 0.
+ *
+ * @return
+ *         Interrupt storms since Timer_RP2040_SimReset.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_SimIrqStorms ( void );
+
+/**
+ * Reports the simulated time.
+ *
+ * @return
+ *         Simulated time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_SimNow ( void );
+
+/**
+ * Reports when the next comparator match happens.
+ *
+ * @return
+ *         Simulated time of the next match, or TIMER_RP2040_SIM_NO_EVENT if no alarm is armed or the timer is paused.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint64 Timer_RP2040_SimNextEvent ( void );
+
+/**
+ * Advances the simulated time to 'time', stopping at every comparator match on the way to raise the alarm
+ * interrupts and run the handler. Alarms armed by the handler are honoured in the same call.
+ * @param time: Simulated time to advance to, at or after Timer_RP2040_SimNow.
+ *
+ * @return
+ *         Number of comparator matches.
+ *
+ * @pre n/a
+ * @post Timer_RP2040_SimNow reports 'time' (unless the timer is paused).
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_SimAdvanceTo ( uint64 time );
+
+/**
+ * Advances the simulated time by 'delta' microseconds, see Timer_RP2040_SimAdvanceTo.
+ * @param delta: Microseconds to advance.
+ *
+ * @return
+ *         Number of comparator matches.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_SimAdvance ( uint64 delta );
+
+/**
+ * Jumps to the next comparator match and services it.
+ *
+ * @return
+ *         0: 'E_OK' if an alarm matched
+ *         1: 'E_NOT_OK' if no alarm is armed (time does not move)
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_SimStep ( void );
+
+#endif /* VIRTUAL_TARGET */
+
+#endif /* TIMER_RP2040_SIM_H */
@@ -0,0 +1,165 @@
+/**
+ *
+* @file "Timer_RP2040_Timeout.h"
+* @author Madrick3
+* @brief Timeouts for polling loops. A timeout holds the start time and the budget, and is checked with
+*   Timer_RP2040_TimeoutStart(&timeout, 500);
+*   while( (0 == (SFR & READY)) && (0 == Timer_RP2040_TimeoutExpired(&timeout)) ) { }
+*
+* The 32 bit form costs one TIMERAWL load per check: the elapsed time is the unsigned difference to the start, which
+* stays correct across the 2^32 us wrap. Budgets must be below TIMER_RP2040_HALF_RANGE32 (about 35 minutes), so that
+* a timeout checked late still reads expired for at least as long again. Longer budgets use the 64 bit form, which
+* reads the full time instead.
+*
+* All functions are inline, keep no state outside the timeout object and only read the timer, so they may be used from
+* interrupts and from both cores - each timeout object belongs to the context that started it.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-025   |  Initial Creation
+************************************************************/
+#if !defined( TIMER_RP2040_TIMEOUT_H )
+#define TIMER_RP2040_TIMEOUT_H
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Timeout of less than 2^31 us, see Timer_RP2040_TimeoutStart */
+typedef struct Timer_RP2040_Timeout_Tag {
+  /* TIMERAWL when the timeout was started */
+  uint32 start;
+  uint32 budget;
+} tTimer_RP2040_Timeout;
+
+/* Timeout of any length, see Timer_RP2040_TimeoutStart64 */
+typedef struct Timer_RP2040_Timeout64_Tag {
+  uint64 start;
+  uint64 budget;
+} tTimer_RP2040_Timeout64;
+
+/************************************************************
+  INLINE FUNCTIONS
+************************************************************/
+
+/**
+ * Starts a timeout of 'budget' microseconds from now.
+ * @param timeout: Timeout to start.
+ * @param budget: Microseconds until the timeout expires, must be below TIMER_RP2040_HALF_RANGE32.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Timer module was previously enabled.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE void Timer_RP2040_TimeoutStart ( tTimer_RP2040_Timeout * timeout, uint32 budget )
+{
+  timeout->start = Timer_RP2040_Now32();
+  timeout->budget = budget;
+}
+
+/**
+ * Checks whether the budget of a timeout has been used up.
+ * @param timeout: Timeout started with Timer_RP2040_TimeoutStart.
+ *
+ * @return
+ *         1 if the timeout has expired, 0 otherwise.
+ *
+ * @pre Checked within 2^31 us after the timeout expired.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint8 Timer_RP2040_TimeoutExpired ( const tTimer_RP2040_Timeout * timeout )
+{
+  return (uint8)((uint32)(Timer_RP2040_Now32() - timeout->start) >= timeout->budget);
+}
+
+/**
+ * Reports the time left until a timeout expires.
+ * @param timeout: Timeout started with Timer_RP2040_TimeoutStart.
+ *
+ * @return
+ *         Microseconds left, 0 once the timeout has expired.
+ *
+ * @pre Checked within 2^31 us after the timeout expired.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint32 Timer_RP2040_TimeoutRemaining ( const tTimer_RP2040_Timeout * timeout )
+{
+  uint32 elapsed = Timer_RP2040_Now32() - timeout->start;
+
+  return (elapsed >= timeout->budget) ? ZERO32 : (timeout->budget - elapsed);
+}
+
+/**
+ * Starts a timeout of 'budget' microseconds from now, for budgets of 2^31 us and more.
+ * @param timeout: Timeout to start.
+ * @param budget: Microseconds until the timeout expires.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Timer module was previously enabled.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE void Timer_RP2040_TimeoutStart64 ( tTimer_RP2040_Timeout64 * timeout, uint64 budget )
+{
+  timeout->start = Timer_RP2040_Now64();
+  timeout->budget = budget;
+}
+
+/**
+ * Checks whether the budget of a 64 bit timeout has been used up.
+ * @param timeout: Timeout started with Timer_RP2040_TimeoutStart64.
+ *
+ * @return
+ *         1 if the timeout has expired, 0 otherwise.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint8 Timer_RP2040_TimeoutExpired64 ( const tTimer_RP2040_Timeout64 * timeout )
+{
+  return (uint8)((Timer_RP2040_Now64() - timeout->start) >= timeout->budget);
+}
+
+/**
+ * Reports the time left until a 64 bit timeout expires.
+ * @param timeout: Timeout started with Timer_RP2040_TimeoutStart64.
+ *
+ * @return
+ *         Microseconds left, 0 once the timeout has expired.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_INLINE uint64 Timer_RP2040_TimeoutRemaining64 ( const tTimer_RP2040_Timeout64 * timeout )
+{
+  uint64 elapsed = Timer_RP2040_Now64() - timeout->start;
+
+  return (elapsed >= timeout->budget) ? 0 : (timeout->budget - elapsed);
+}
+
+#endif /* TIMER_RP2040_TIMEOUT_H */
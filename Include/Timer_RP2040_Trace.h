@@ -0,0 +1,198 @@
+/**
+ *
+* @file "Timer_RP2040_Trace.h"
+* @author Madrick3
+* @brief Compact binary event trace for the RP2040 timer. Each record holds an event id, a 32 bit argument and the
+* TIMERAWL time, in a RAM ring of TIMER_RP2040_TRACE_BYTES bytes. When the ring is full the oldest records are
+* dropped.
+*
+* A record is encoded as:
+*   varint(time - time of the previous record) | event id (1 byte) | varint(argument)
+* Varints hold 7 bits per byte, least significant group first, with bit 7 set on every byte but the last. Events a
+* few milliseconds apart with small arguments take 3 to 5 bytes, against 13 for a raw 64 bit stamp, id and argument.
+* Two consecutive records must be less than 2^32 us (about 71 minutes) apart.
+*
+* Timer_RP2040_TraceExport copies the ring into a self-contained image:
+*   base time (4 bytes) | dropped records (4 bytes) | data length (4 bytes) | data
+* with little endian header fields, where the base time is the TIMERAWL value the first delta is relative to. The
+* reader functions decode an image on the target or on the host (see Test/Timer_RP2040_TraceDecode.c).
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.02.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-016   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-016   |  Ring size must hold the longest record
+************************************************************/
+#if !defined( TIMER_RP2040_TRACE_H )
+#define TIMER_RP2040_TRACE_H
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Size of the ring in bytes, a power of two no smaller than one record. May be overriden by the build. */
+#if !defined( TIMER_RP2040_TRACE_BYTES )
+#define TIMER_RP2040_TRACE_BYTES 1024uL
+#endif
+
+#define TIMER_RP2040_TRACE_MASK (TIMER_RP2040_TRACE_BYTES - 1uL)
+
+/* Longest encoded record: two 5 byte varints and the event id */
+#define TIMER_RP2040_TRACE_RECORD_MAX 11
+
+/* Size of the image header written by Timer_RP2040_TraceExport */
+#define TIMER_RP2040_TRACE_HEADER_BYTES 12uL
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040.h"
+
+/*
+  Critical section around the ring. Records may be written from any context, so the default masks interrupts on the
+  RP2040 and, with TIMER_RP2040_MULTICORE, also takes the trace lock. The single threaded host build needs neither.
+  'state' is a uint32 that holds what is needed to leave the section.
+*/
+#if !defined( TIMER_RP2040_TRACE_ENTER_CRITICAL )
+#if ( TIMER_RP2040_MULTICORE != 0 )
+#define TIMER_RP2040_TRACE_ENTER_CRITICAL(state) TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_TRACE, state)
+#define TIMER_RP2040_TRACE_EXIT_CRITICAL(state)  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_TRACE, state)
+#elif !defined( VIRTUAL_TARGET )
+#define TIMER_RP2040_TRACE_ENTER_CRITICAL(state) \
+  __asm__ __volatile__ ( "mrs %0, primask\n\tcpsid i" : "=r" (state) : : "memory" )
+#define TIMER_RP2040_TRACE_EXIT_CRITICAL(state)  __asm__ __volatile__ ( "msr primask, %0" : : "r" (state) : "memory" )
+#else
+#define TIMER_RP2040_TRACE_ENTER_CRITICAL(state) ((state) = ZERO32)
+#define TIMER_RP2040_TRACE_EXIT_CRITICAL(state)  ((void)(state))
+#endif
+#endif
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* One decoded trace record */
+typedef struct Timer_RP2040_TraceEvent_Tag {
+  /* Base time of the image plus all deltas up to this record - the low 32 bits are the TIMERAWL value */
+  uint64 time;
+  uint32 argument;
+  uint8 id;
+} tTimer_RP2040_TraceEvent;
+
+/* Decoding state of an exported image, see Timer_RP2040_TraceReaderInit */
+typedef struct Timer_RP2040_TraceReader_Tag {
+  const uint8 * data;
+  uint32 length;
+  uint32 offset;
+  uint64 time;
+  /* Records dropped from the ring before the image was taken */
+  uint32 dropped;
+} tTimer_RP2040_TraceReader;
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the trace, dropping any recorded events.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The trace is empty, the base time is the current time.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_TraceInit ( void );
+
+/**
+ * Appends an event stamped with the current TIMERAWL time, dropping the oldest records if the ring is full. May be
+ * called from any context, including interrupts and the other core.
+ * @param eventId: Application defined event id.
+ * @param argument: Application defined argument - small values encode shorter.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the trace is not yet initialized
+ *
+ * @pre Trace was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_TraceRecord ( uint8 eventId, uint32 argument );
+
+/**
+ * Copies the trace into 'image' in the format described above. Recording continues during and after the export.
+ * @param image: Receives the image.
+ * @param size: Size of 'image' in bytes - TIMER_RP2040_TRACE_HEADER_BYTES + TIMER_RP2040_TRACE_BYTES always fits.
+ * @param length: Receives the length of the image.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the image does not fit into 'size' bytes
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the trace is not yet initialized
+ *
+ * @pre Trace was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_TraceExport ( uint8 * image, uint32 size, uint32 * length );
+
+/**
+ * Reports the number of records dropped because the ring was full.
+ *
+ * @return
+ *         Dropped records since Timer_RP2040_TraceInit.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern uint32 Timer_RP2040_TraceDropped ( void );
+
+/**
+ * Prepares 'reader' to decode an image made by Timer_RP2040_TraceExport. Needs no initialized timer.
+ * @param reader: Decoding state.
+ * @param image: Exported image, must stay valid while reading.
+ * @param length: Length of the image in bytes.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid or the header does not match 'length'
+ *
+ * @pre n/a
+ * @post The first Timer_RP2040_TraceNext reports the oldest record.
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_TraceReaderInit ( tTimer_RP2040_TraceReader * reader, const uint8 * image,
+                                                    uint32 length );
+
+/**
+ * Decodes the next record of an image.
+ * @param reader: Decoding state from Timer_RP2040_TraceReaderInit.
+ * @param event: Receives the record.
+ *
+ * @return
+ *         0: 'E_OK' if a record was decoded
+ *         1: 'E_NOT_OK' if all records have been read
+ *         2: 'E_PARAM' if an input parameter is not valid or the record is truncated
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+extern Std_ErrorCode Timer_RP2040_TraceNext ( tTimer_RP2040_TraceReader * reader, tTimer_RP2040_TraceEvent * event );
+
+#endif /* TIMER_RP2040_TRACE_H */
@@ -2,6 +2,12 @@
 $(info Executing: Components/Timer_RP2040/make/Timer_RP2040.mak)
 #C files that should be compiled in this component
 C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Sched.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Defer.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Conv.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Trace.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Prof.c
+C_SOURCE_FILES += Components/Timer_RP2040/Source/Timer_RP2040_Delay.c
 
 #include path for header files in this component
 INCLUDE_PATH += $(ROOT_DIR)/Components/Timer_RP2040/Include
@@ -23,6 +23,20 @@
   DEFINES
 ************************************************************/
 
+/* Index of the lowest set bit of a non-zero bitmap */
+#if defined( __GNUC__ )
+#define TIMER_RP2040_CTZ(bitmap) ((uint8)__builtin_ctz(bitmap))
+#else
+#define TIMER_RP2040_CTZ(bitmap) Timer_RP2040_Ctz(bitmap)
+#endif
+
+/* Latency histogram bucket of 'value': 0 for 0, otherwise the bit length of the value */
+#if defined( __GNUC__ )
+#define TIMER_RP2040_LOG2_BUCKET(value) ((ZERO32 == (value)) ? 0 : (uint8)(32 - __builtin_clz(value)))
+#else
+#define TIMER_RP2040_LOG2_BUCKET(value) Timer_RP2040_BitLength(value)
+#endif
+
 /************************************************************
   INCLUDES
 ************************************************************/
@@ -33,18 +47,91 @@
   ENUMS AND TYPEDEFS
 ************************************************************/
 
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/*
+  Live latency statistics of one alarm. Written by Timer_RP2040_IrqHandler only; 'sequence' is odd while an update is
+  in progress, so readers retry instead of taking a lock in the interrupt.
+*/
+typedef struct Timer_RP2040_Latency_Tag {
+  volatile uint32 sequence;
+  uint32 count;
+  uint32 min;
+  uint32 max;
+  uint64 sum;
+  uint32 bucket[TIMER_RP2040_LATENCY_BUCKETS];
+} tTimer_RP2040_Latency;
+#endif
+
+/* State of a periodic alarm, see Timer_RP2040_PeriodicStart */
+typedef struct Timer_RP2040_Periodic_Tag {
+  /* Absolute TIMELR value of the period in progress */
+  uint32 deadline;
+  uint32 period;
+  /* Periods skipped because the handler ran after the following deadline */
+  uint32 skipped;
+  tTimer_RP2040_AlarmCallback callback;
+  void * context;
+  /* Cleared by Timer_RP2040_PeriodicStop under the driver lock - a stopped alarm is not re-armed */
+  uint8 active;
+} tTimer_RP2040_Periodic;
+
 
 /************************************************************
   LOCAL VARIABLES
 ************************************************************/
 TIMER_RP2040_LOCAL tTimer_RP2040_Status Timer_RP2040_Status = TIMER_RP2040_UNINIT;
 
+/* IRQ dispatch table - one callback and context per alarm, and a bitmap of the alarms with a callback. */
+TIMER_RP2040_LOCAL tTimer_RP2040_AlarmCallback Timer_RP2040_Callback[ALARM_MAX_INDEX + 1];
+
+TIMER_RP2040_LOCAL void * Timer_RP2040_CallbackContext[ALARM_MAX_INDEX + 1];
+
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_CallbackBitmap = ZERO32;
+
+TIMER_RP2040_LOCAL tTimer_RP2040_Periodic Timer_RP2040_Periodic[ALARM_MAX_INDEX + 1];
+
+/* 64 bit deadlines given to Timer_RP2040_ArmAlarmAt64, and a bitmap of the alarms armed for an intermediate wake */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_Deadline64[ALARM_MAX_INDEX + 1];
+
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_ParkedBitmap = ZERO32;
+
+/* Alarms whose interrupt was forced through INTF because their deadline had passed when armed */
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_ForcedBitmap = ZERO32;
+
+#if ( TIMER_RP2040_SHADOW != 0 )
+/* SRAM copies of INTE and of the ALARMn values last written - only changed under the driver lock */
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_ShadowInte = ZERO32;
+
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_ShadowAlarm[ALARM_MAX_INDEX + 1];
+
+#define TIMER_RP2040_ALARM_STORE(n, value) \
+  (Timer_RP2040_ShadowAlarm[(n)] = (value), TIMER_REG_ALARM_WRITE((n), Timer_RP2040_ShadowAlarm[(n)]))
+#define TIMER_RP2040_ALARM_LOAD(n)         (Timer_RP2040_ShadowAlarm[(n)])
+#else
+#define TIMER_RP2040_ALARM_STORE(n, value) TIMER_REG_ALARM_WRITE((n), (value))
+#define TIMER_RP2040_ALARM_LOAD(n)         TIMER_REG_READ(TIMER_REG_ALARMn(n))
+#endif
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+TIMER_RP2040_LOCAL tTimer_RP2040_Latency Timer_RP2040_Latency[ALARM_MAX_INDEX + 1];
+#endif
+
+#if ( TIMER_RP2040_MULTICORE != 0 ) && defined( VIRTUAL_TARGET )
+/* Host stand-in for the SIO spinlocks, see Timer_RP2040_Lock.h */
+volatile uint32 Timer_RP2040_LockWord[TIMER_RP2040_LOCK_COUNT];
+#endif
+
 #if defined ( VIRTUAL_TARGET )
 
 TIMER_RP2040_LOCAL const tRP2040_Timer Timer_Uninit = { 0 };
 
 TIMER_RP2040_LOCAL volatile tRP2040_Timer Timer_Live;
 
+#if ( TIMER_RP2040_REG_PROBE != 0 )
+/* Register accesses made through the TIMER_REG_ macros, see Timer_RP2040_SFR.h */
+uint32 Timer_RP2040_RegAccessCount = ZERO32;
+#endif
+
 #endif /* VIRTUAL_TARGET */
 
 
@@ -52,6 +139,60 @@ TIMER_RP2040_LOCAL volatile tRP2040_Timer Timer_Live;
   LOCAL FUNCTIONS
 ************************************************************/
 
+#if !defined( __GNUC__ )
+/**
+ * Portable count trailing zeros for the four alarm bits.
+ * @param bitmap: Non-zero alarm bitmap.
+ *
+ * @return 
+ *         Index of the lowest set bit.
+ *
+ * @pre bitmap is not zero.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_Ctz ( uint32 bitmap )
+{
+  uint8 index = 0;
+
+  while( 0 == (bitmap & 1uL) )
+  {
+    bitmap >>= 1;
+    index++;
+  }
+
+  return index;
+}
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/**
+ * Portable bit length, the latency histogram bucket of a value.
+ * @param value: Latency in microseconds.
+ *
+ * @return 
+ *         0 for 0, otherwise the index of the highest set bit plus one.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_BitLength ( uint32 value )
+{
+  uint8 length = 0;
+
+  while( ZERO32 != value )
+  {
+    value >>= 1;
+    length++;
+  }
+
+  return length;
+}
+#endif
+#endif
+
 /**
  * Writes to the TIMER_PAUSE register, reports E_OK if Timer is paused. Reports E_NOT_OK if the timer did not pause.
  *
@@ -75,13 +216,13 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_Pause ( void )
   /* if pre-checks are performed, lets do the actual pause. */
   if( E_OK == retVal )
   {
-    *TIMER_REG_PAUSE = (TIMER_PAUSE_MASK & TIMER_PAUSE_SET);
+    TIMER_REG_WRITE(TIMER_REG_PAUSE, (TIMER_PAUSE_MASK & TIMER_PAUSE_SET));
   }
 
   /* Check to see if the timer is paused - if it is, return ok, otherwise report notok */
   if( E_OK == retVal )
   {
-    if( TIMER_PAUSE_SET != (*TIMER_REG_PAUSE & TIMER_PAUSE_MASK) )
+    if( TIMER_PAUSE_SET != (TIMER_REG_READ(TIMER_REG_PAUSE) & TIMER_PAUSE_MASK) )
     {
       /* Timer was not paused - report an error. */
       retVal = E_NOT_OK;
@@ -115,13 +256,13 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_Unpause ( void )
   /* if pre-checks are performed, lets do the actual unpause. */
   if( E_OK == retVal )
   {
-    *TIMER_REG_PAUSE = (TIMER_PAUSE_MASK & TIMER_PAUSE_CLR);
+    TIMER_REG_WRITE(TIMER_REG_PAUSE, (TIMER_PAUSE_MASK & TIMER_PAUSE_CLR));
   }
 
   /* Check to see if the timer is unpaused - if it is, return ok, otherwise report notok */
   if( E_OK == retVal )
   {
-    if( TIMER_PAUSE_CLR != (*TIMER_REG_PAUSE & TIMER_PAUSE_MASK) )
+    if( TIMER_PAUSE_CLR != (TIMER_REG_READ(TIMER_REG_PAUSE) & TIMER_PAUSE_MASK) )
     {
       /* Timer is paused - report an error. */
       retVal = E_NOT_OK;
@@ -141,7 +282,7 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_nodebugpause ( void )
   /* if pre-checks are performed, lets do the actual unpause. */
   if( E_OK == retVal )
   {
-    *TIMER_REG_DBGPAUSE = (0);
+    TIMER_REG_WRITE(TIMER_REG_DBGPAUSE, 0);
   }
   
   return retVal;
@@ -181,7 +322,7 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_ReadTimerLow ( uint32 * TimerLow )
   /* if pre-checks are performed, read from the register. */
   if( E_OK == retVal )
   {
-    *TimerLow = *TIMER_REG_TIMELR;
+    *TimerLow = TIMER_REG_READ(TIMER_REG_TIMELR);
   }
 
   /* No post-checks are considered for this read. */
@@ -223,7 +364,7 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_ReadTimerHigh ( uint32 * TimerHigh
   /* if pre-checks are performed, read from the register. */
   if( E_OK == retVal )
   {
-    *TimerHigh = *TIMER_REG_TIMEHR;
+    *TimerHigh = TIMER_REG_READ(TIMER_REG_TIMEHR);
   }
 
   /* No post-checks are considered for this read. */
@@ -254,7 +395,7 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_WriteTimerLow ( uint32 TimerLow )
   /* if pre-checks are performed, write to the register. */
   if( E_OK == retVal )
   {
-    *TIMER_REG_TIMELW = TimerLow;
+    TIMER_REG_WRITE(TIMER_REG_TIMELW, TimerLow);
   }
 
   /* No post-checks are considered for this write . */
@@ -285,11 +426,8 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_WriteTimerHigh ( uint32 TimerHigh
   /* if pre-checks are performed, write to the register. */
   if( E_OK == retVal )
   {
-    /* 
-      For test-cases, we have to cast TIMER_REG_TIMEHW as a uint32. 
-      Writes will fail otherwise, since SFR_IOS is 64bit length in virtual target
-    */
-    *(uint32 *)TIMER_REG_TIMEHW = TimerHigh;
+    /* TIMER_REG_WRITE stores 32 bits - SFR_IOS is 64bit length in virtual target */
+    TIMER_REG_WRITE(TIMER_REG_TIMEHW, TimerHigh);
   }
 
   /* No post-checks are considered for this write . */
@@ -299,6 +437,288 @@ TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_WriteTimerHigh ( uint32 TimerHigh
 
 
 
+/**
+ * Fires the interrupts of alarms whose deadline was missed, through INTF. The forced bits are remembered so that
+ * Timer_RP2040_IrqHandler, Timer_RP2040_InterruptClearN or Timer_RP2040_DisarmAlarmN release them again - INTF is not
+ * cleared by the INTR acknowledge.
+ * @param bitmap: Alarms to fire.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre The driver lock is held.
+ * @post The alarm interrupts are pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_ForceExpired ( uint32 bitmap )
+{
+  Timer_RP2040_ForcedBitmap |= bitmap;
+  TIMER_REG_SET(TIMER_REG_INTF, bitmap);
+}
+
+/**
+ * Releases the INTF bits set by Timer_RP2040_ForceExpired for the alarms in 'bitmap'. Bits forced through
+ * Timer_RP2040_InterruptNTrigger are left alone.
+ * @param bitmap: Alarms to release.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre The driver lock is held.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_ForcedRelease ( uint32 bitmap )
+{
+  bitmap &= Timer_RP2040_ForcedBitmap;
+
+  if( ZERO32 != bitmap )
+  {
+    Timer_RP2040_ForcedBitmap &= ~bitmap;
+    TIMER_REG_CLR(TIMER_REG_INTF, bitmap);
+  }
+}
+
+/**
+ * Writes the comparator of an alarm and checks that the deadline was not missed. Once the time has reached
+ * 'triggerTime' the comparator only matches again after a full 2^32 us wrap, so an alarm which is still armed at
+ * that point has missed its deadline and is disarmed again. A match which did happen has already cleared ARMED.
+ * An interrupt forced for the previous deadline is released first, it does not belong to the new one.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param triggerTime: 32 bit value for the alarm, 0 is allowed.
+ *
+ * @return 
+ *         1 if the deadline was missed and the alarm is disarmed, 0 if the alarm is armed or has matched.
+ *
+ * @pre alarmIndex is valid, the driver lock is held. 'triggerTime' is less than 2^31 us from now.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_ArmChecked ( uint8 alarmIndex, uint32 triggerTime )
+{
+  uint8 missed = 0;
+
+  Timer_RP2040_ParkedBitmap &= ~INT_TO_BITMAP(alarmIndex);
+  Timer_RP2040_ForcedRelease(INT_TO_BITMAP(alarmIndex));
+  TIMER_RP2040_ALARM_STORE(alarmIndex, triggerTime);
+
+  /* The time is read before ARMED: a match up to that time has cleared the bit by then */
+  if( ((uint32)(Timer_RP2040_RawNow32() - triggerTime) < TIMER_RP2040_HALF_RANGE32) &&
+      (ZERO32 != (TIMER_REG_READ(TIMER_REG_ARMED) & INT_TO_BITMAP(alarmIndex))) )
+  {
+    TIMER_REG_W1C(TIMER_REG_ARMED, INT_TO_BITMAP(alarmIndex));
+    missed = 1;
+  }
+
+  return missed;
+}
+
+/**
+ * Disarms the alarms in 'bitmap' with a single ARMED write. The comparators keep their last value - 0 is a valid
+ * trigger time, so no ALARMn value can mark an alarm as disarmed.
+ * @param bitmap: Alarms to disarm.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre The driver lock is held.
+ * @post The alarms are disarmed and none of their interrupts is forced.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_Disarm ( uint32 bitmap )
+{
+  Timer_RP2040_ParkedBitmap &= ~bitmap;
+  TIMER_REG_W1C(TIMER_REG_ARMED, bitmap);
+  Timer_RP2040_ForcedRelease(bitmap);
+}
+
+/**
+ * Programs the 32 bit comparator for the alarm's 64 bit deadline. A deadline inside the comparator window is armed
+ * directly, a deadline further out is parked: the comparator is armed for an intermediate wake one window from now
+ * and the deadline is re-evaluated by Timer_RP2040_IrqHandler when it fires. A deadline which has passed forces the
+ * alarm interrupt instead.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param now: Current time in microseconds.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre alarmIndex is valid, the driver lock is held.
+ * @post The alarm is armed, or its interrupt is pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_ArmWindow ( uint8 alarmIndex, uint64 now )
+{
+  uint64 deadline = Timer_RP2040_Deadline64[alarmIndex];
+
+  if( deadline > (now + TIMER_RP2040_ALARM_WINDOW_US) )
+  {
+    Timer_RP2040_ParkedBitmap |= INT_TO_BITMAP(alarmIndex);
+    Timer_RP2040_ForcedRelease(INT_TO_BITMAP(alarmIndex));
+    TIMER_RP2040_ALARM_STORE(alarmIndex, (uint32)(now + TIMER_RP2040_ALARM_WINDOW_US));
+  }
+  else if( (deadline <= now) || (0 != Timer_RP2040_ArmChecked(alarmIndex, (uint32)deadline)) )
+  {
+    /* Passed before the write, or while it landed */
+    Timer_RP2040_ParkedBitmap &= ~INT_TO_BITMAP(alarmIndex);
+    Timer_RP2040_ForceExpired(INT_TO_BITMAP(alarmIndex));
+  }
+  else
+  {
+    /* Armed on the deadline */
+  }
+}
+
+/**
+ * Services the intermediate wake of a parked alarm: the alarm is re-armed towards its deadline unless the deadline
+ * has been reached.
+ * @param alarmIndex: Index of the parked alarm.
+ *
+ * @return 
+ *         1 if the deadline has been reached and the alarm is due, 0 if it was re-armed.
+ *
+ * @pre alarmIndex is valid.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_ParkedWake ( uint8 alarmIndex )
+{
+  uint8 due = 0;
+  uint64 now;
+  uint32 lockState;
+
+  TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  now = Timer_RP2040_RawNow64();
+  if( now >= Timer_RP2040_Deadline64[alarmIndex] )
+  {
+    Timer_RP2040_ParkedBitmap &= ~INT_TO_BITMAP(alarmIndex);
+    due = 1;
+  }
+  else
+  {
+    Timer_RP2040_ArmWindow(alarmIndex, now);
+  }
+  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+  return due;
+}
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/**
+ * Records the latency of an alarm callback about to run: TIMERAWL minus the programmed ALARMn value, wrap-safe.
+ * @param alarmIndex: Alarm being serviced.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre Called from Timer_RP2040_IrqHandler only, for a comparator match or a forced missed deadline.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_LatencyRecord ( uint8 alarmIndex )
+{
+  tTimer_RP2040_Latency * latency = &Timer_RP2040_Latency[alarmIndex];
+  uint32 late = Timer_RP2040_RawNow32() - TIMER_RP2040_ALARM_LOAD(alarmIndex);
+
+  latency->sequence++;
+  TIMER_RP2040_MEMORY_BARRIER();
+
+  if( (ZERO32 == latency->count) || (late < latency->min) )
+  {
+    latency->min = late;
+  }
+  if( late > latency->max )
+  {
+    latency->max = late;
+  }
+  latency->count++;
+  latency->sum += late;
+  latency->bucket[TIMER_RP2040_LOG2_BUCKET(late)]++;
+
+  TIMER_RP2040_MEMORY_BARRIER();
+  latency->sequence++;
+}
+#endif
+
+/**
+ * Writes the compare value of a periodic alarm, unless it has been stopped meanwhile. A deadline missed while the
+ * write lands forces the interrupt, so the period is serviced late instead of stalling for a wrap.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param deadline: 32 bit value for the alarm.
+ *
+ * @return 
+ *         1 if the alarm is armed, 0 if it has been stopped.
+ *
+ * @pre alarmIndex is valid.
+ * @post The alarm is armed if it is still active.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_PeriodicArm ( uint8 alarmIndex, uint32 deadline )
+{
+  uint8 active;
+  uint32 lockState;
+
+  TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  active = Timer_RP2040_Periodic[alarmIndex].active;
+  if( (0 != active) && (0 != Timer_RP2040_ArmChecked(alarmIndex, deadline)) )
+  {
+    Timer_RP2040_ForceExpired(INT_TO_BITMAP(alarmIndex));
+  }
+  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+  return active;
+}
+
+/**
+ * Alarm callback behind every periodic alarm. The next deadline is the previous deadline plus the period, never the
+ * current time plus the period, so interrupt latency shows up as jitter but does not accumulate as drift. If the
+ * handler runs after the next deadline has already passed, the missed periods are skipped (and counted) so that the
+ * alarm is armed for the first deadline not in the past and stays in phase.
+ * @param alarmIndex: Alarm which fired.
+ * @param context: The alarm's tTimer_RP2040_Periodic.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre The alarm was started with Timer_RP2040_PeriodicStart.
+ * @post The alarm is armed for the next period, and the user callback has run - neither if it has been stopped.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_PeriodicIrq ( uint8 alarmIndex, void * context )
+{
+  tTimer_RP2040_Periodic * periodic = (tTimer_RP2040_Periodic *)context;
+  uint32 late;
+  uint32 skipped;
+
+  periodic->deadline += periodic->period;
+
+  /*
+    Wrap-safe 'now > deadline': the difference is below half the 32 bit range once the deadline has passed. Only
+    deadlines strictly in the past are skipped - one that is due right now is armed, and PeriodicArm forces it.
+  */
+  late = (uint32)(Timer_RP2040_RawNow32() - periodic->deadline);
+  if( (ZERO32 != late) && (late < TIMER_RP2040_HALF_RANGE32) )
+  {
+    skipped = ((late - 1uL) / periodic->period) + 1uL;
+    periodic->deadline += skipped * periodic->period;
+    periodic->skipped += skipped;
+  }
+
+  if( 0 != Timer_RP2040_PeriodicArm(alarmIndex, periodic->deadline) )
+  {
+    periodic->callback(alarmIndex, periodic->context);
+  }
+}
+
 /************************************************************
   EXTERN FUNCTIONS
 ************************************************************/
@@ -330,6 +750,13 @@ Std_ErrorCode Timer_RP2040_Init ( void )
     retVal = E_NOT_OK;
   }
 
+#if ( TIMER_RP2040_SHADOW != 0 )
+  /* INTE and ALARMn keep their values over a soft reset - start the shadow from what is there */
+  if( E_OK == retVal ){
+    Timer_RP2040_ShadowSync();
+  }
+#endif
+
   /* First lets pause and clear the timer */
   if( E_OK == retVal ){
     retVal = Timer_RP2040_Pause();
@@ -338,11 +765,13 @@ Std_ErrorCode Timer_RP2040_Init ( void )
     }
   }
 
-  /* Now, lets prepare an alarm */
+  /* Now, lets prepare an alarm - a tickless system arms alarms for real events only */
+#if ( TIMER_RP2040_TICKLESS == 0 )
   if( E_OK == retVal ){
     /* Sets alarm0 for 1000us (1ms) */
     retVal = Timer_RP2040_ArmAlarmN(ALARM0_INDEX, 1000);
   }
+#endif
 
   /* First lets unpause the timer */
   if( E_OK == retVal ){
@@ -393,11 +822,7 @@ Std_ErrorCode Timer_RP2040_Deinit ( void )
   if( E_OK == retVal )
   {
     /* Disable all 4 possible alarms */
-    /* Possible improvement to provide 'DisableAllAlarms' API or 'DisableAlarmBitmask' API */
-    retVal |= Timer_RP2040_DisarmAlarmN(ALARM0_INDEX);
-    retVal |= Timer_RP2040_DisarmAlarmN(ALARM1_INDEX);
-    retVal |= Timer_RP2040_DisarmAlarmN(ALARM2_INDEX);
-    retVal |= Timer_RP2040_DisarmAlarmN(ALARM3_INDEX);
+    retVal |= Timer_RP2040_DisarmAlarms(TIMER_RP2040_ALLALARMS_BITMASK);
   }
 
   /* Disable all interrupts */
@@ -418,6 +843,24 @@ Std_ErrorCode Timer_RP2040_Deinit ( void )
 }
 
 
+/**
+ * Reports the init status of the timer module.
+ *
+ * @return 
+ *         0: 'TIMER_RP2040_UNINIT' if the timer is not yet initialized
+ *         1: 'TIMER_RP2040_INIT' if the timer is initialized
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+tTimer_RP2040_Status Timer_RP2040_IsInit ( void )
+{
+  return Timer_RP2040_Status;
+}
+
+
 /**
  * Enables interrupts for the ALARMS given by the bitmask parameter.
  * @param bmp_intEnable: bitmap for which interrupts should be enabled. Acceptable values are between (and including) 1d (0b0001) and 15d (0b1111)
@@ -436,6 +879,9 @@ Std_ErrorCode Timer_RP2040_Deinit ( void )
 Std_ErrorCode Timer_RP2040_InterruptEnable (  uint32 bmp_intEnable )
 {
   Std_ErrorCode retVal = E_OK;
+#if ( TIMER_RP2040_SHADOW != 0 )
+  uint32 lockState;
+#endif
   
   /* Check that the module was previously init */
   if( TIMER_RP2040_INIT != Timer_RP2040_Status )
@@ -459,7 +905,15 @@ Std_ErrorCode Timer_RP2040_InterruptEnable (  uint32 bmp_intEnable )
   /* Write to the INTE register with the bitmask */
   if( E_OK == retVal )
   {
-    *TIMER_REG_INTE = (*TIMER_REG_INTE | bmp_intEnable);
+    /* Single write to the SET alias - atomic against the other core and interrupts */
+#if ( TIMER_RP2040_SHADOW != 0 )
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_ShadowInte |= bmp_intEnable;
+    TIMER_REG_SET(TIMER_REG_INTE, bmp_intEnable);
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+#else
+    TIMER_REG_SET(TIMER_REG_INTE, bmp_intEnable);
+#endif
   }
 
   return retVal;
@@ -483,6 +937,9 @@ Std_ErrorCode Timer_RP2040_InterruptEnable (  uint32 bmp_intEnable )
 Std_ErrorCode Timer_RP2040_InterruptDisable (  uint8  bmp_intDisable )
 {
   Std_ErrorCode retVal = E_OK;
+#if ( TIMER_RP2040_SHADOW != 0 )
+  uint32 lockState;
+#endif
   
   /* Check that the module was previously init */
   if( TIMER_RP2040_INIT != Timer_RP2040_Status )
@@ -506,13 +963,67 @@ Std_ErrorCode Timer_RP2040_InterruptDisable (  uint8  bmp_intDisable )
   /* Write to the INTE register with the bitmask */
   if( E_OK == retVal )
   {
-    /* bitmap must be inverted to write '0' to disable. */
-    *TIMER_REG_INTE = *TIMER_REG_INTE & (~((uint32)bmp_intDisable));
+    /* Single write to the CLR alias - atomic against the other core and interrupts */
+#if ( TIMER_RP2040_SHADOW != 0 )
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_ShadowInte &= ~(uint32)bmp_intDisable;
+    TIMER_REG_CLR(TIMER_REG_INTE, bmp_intDisable);
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+#else
+    TIMER_REG_CLR(TIMER_REG_INTE, bmp_intDisable);
+#endif
   }
 
   return retVal;
 }
 
+/**
+ * Reports the alarm interrupts which are enabled.
+ *
+ * @return 
+ *         Bitmap of the enabled alarm interrupts.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_InterruptEnabled ( void )
+{
+#if ( TIMER_RP2040_SHADOW != 0 )
+  return Timer_RP2040_ShadowInte;
+#else
+  return TIMER_REG_READ(TIMER_REG_INTE);
+#endif
+}
+
+#if ( TIMER_RP2040_SHADOW != 0 )
+/**
+ * Reloads the shadow registers from INTE and ALARMn.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre n/a
+ * @post The shadow registers match the TIMER.
+ * @invariant n/a
+ *
+ */
+void Timer_RP2040_ShadowSync ( void )
+{
+  uint32 lockState;
+  uint8 alarmIndex;
+
+  TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  Timer_RP2040_ShadowInte = TIMER_REG_READ(TIMER_REG_INTE);
+  for( alarmIndex = 0; alarmIndex <= ALARM_MAX_INDEX; alarmIndex++ )
+  {
+    Timer_RP2040_ShadowAlarm[alarmIndex] = TIMER_REG_READ(TIMER_REG_ALARMn(alarmIndex));
+  }
+  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+}
+#endif
+
 /**
  * Forces an interrupt flag to be set
  * @param intToTrigger: char
@@ -537,7 +1048,7 @@ Std_ErrorCode Timer_RP2040_InterruptNTrigger (  uint8 intToTrigger )
   }
   else
   {
-    *TIMER_REG_INTF = (*TIMER_REG_INTF | (INT_TO_BITMAP(intToTrigger))); 
+    TIMER_REG_SET(TIMER_REG_INTF, INT_TO_BITMAP(intToTrigger));
   }
 
   return retVal;
@@ -563,7 +1074,7 @@ tTimer_RP2040_AlarmStatus Timer_RP2040_InterruptNStatusCheck (  uint8 interrupt_
   tTimer_RP2040_AlarmStatus interruptStatus = TIMER_RP2040_ALARM_FAILED;
   if(ALARM_MAX_INDEX >= interrupt_to_check)
   {
-    if(1 == (*TIMER_REG_INTS & (INT_TO_BITMAP(interrupt_to_check))))
+    if(1 == (TIMER_REG_READ(TIMER_REG_INTS) & (INT_TO_BITMAP(interrupt_to_check))))
     {
       interruptStatus = TIMER_RP2040_ALARM_TRIGGERED;
     }
@@ -685,13 +1196,44 @@ Std_ErrorCode Timer_RP2040_TimerRead32 (  uint32 *  TimerLow )
   if( E_OK == retVal )
   {
     /* read only from RAW-L register. No side-effects.*/
-    *TimerLow = *TIMER_REG_TIMERAWL;
+    *TimerLow = TIMER_REG_READ(TIMER_REG_TIMERAWL);
   }
 
   return retVal;
 }
 
 
+/**
+ * Reads the 64 bit timer from TIMER_TIMERAWH and TIMER_TIMERAWL with a high-low-high sequence. If TIMERAWH changed
+ * while TIMERAWL was read, the low word wrapped and the read is repeated - this can happen at most once every 2^32us
+ * so the loop does not run more than twice in practice.
+ *
+ * @return 
+ *         Current time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_TimerRead64 ( void )
+{
+  uint32 timeHigh;
+  uint32 timeLow;
+  uint32 timeHighCheck;
+
+  timeHighCheck = TIMER_REG_READ(TIMER_REG_TIMERAWH);
+  do
+  {
+    timeHigh = timeHighCheck;
+    timeLow = TIMER_REG_READ(TIMER_REG_TIMERAWL);
+    timeHighCheck = TIMER_REG_READ(TIMER_REG_TIMERAWH);
+  } while( timeHigh != timeHighCheck );
+
+  return (((uint64)timeHigh) << 32) | (uint64)timeLow;
+}
+
+
 /**
  * Reads the timer from TIMER_TIMERAWL - stores the result in the buffer provided.
  * @param alarmIndex: Index of Alarm to be checked, must be within range [0:3].
@@ -717,27 +1259,24 @@ tTimer_RP2040_AlarmStatus Timer_RP2040_CheckAlarmN ( uint8 alarmIndex )
     retVal = TIMER_RP2040_ALARM_NOT_SET;
   }
 
-  /* If the alarm index is ok - lets read from the relevant alarm register to see the status */
+  /*
+    If the alarm index is ok - the status comes from ARMED and the interrupt flags. The ALARMn value says nothing: 0
+    is a valid trigger time. ARMED is read first, so a match between the two reads is seen as triggered.
+  */
   if( retVal != TIMER_RP2040_ALARM_FAILED )
   {
-    /* if the alarm is zero,*/
-    if( ZERO32 == *TIMER_REG_ALARMn(alarmIndex) )
+    if((TIMER_REG_READ(TIMER_REG_ARMED) & (INT_TO_BITMAP(alarmIndex))) == (INT_TO_BITMAP(alarmIndex)))
     {
-      /* here, we may have triggered the alarm already, so the interrupt must be checked. */
-      if( ZERO32 != (*TIMER_REG_INTS & (INT_TO_BITMAP(alarmIndex))) )
-      {
-        /* 00 !=  (0b0001 && (0b0001)) -> Interrupt is set. */
-        retVal = TIMER_RP2040_ALARM_TRIGGERED;
-      }
+      retVal = TIMER_RP2040_ALARM_SET_NOT_TRIGGERED;
+    }
+    /* Not armed - we may have triggered the alarm already, so the raw or forced interrupt must be checked. */
+    else if( ZERO32 != ((TIMER_REG_READ(TIMER_REG_INTR) | Timer_RP2040_ForcedBitmap) & (INT_TO_BITMAP(alarmIndex))) )
+    {
+      retVal = TIMER_RP2040_ALARM_TRIGGERED;
     }
     else
     {
-      /* If there is a value in the alarm register, we know its not yet been triggered. */
-      /* It could not be cleared - so we should check the armed register */
-      if((*TIMER_REG_ARMED & (INT_TO_BITMAP(alarmIndex))) == (INT_TO_BITMAP(alarmIndex)))
-      {
-        retVal = TIMER_RP2040_ALARM_SET_NOT_TRIGGERED;
-      }
+      /* Neither armed nor fired */
     }
   }
 
@@ -751,57 +1290,70 @@ tTimer_RP2040_AlarmStatus Timer_RP2040_CheckAlarmN ( uint8 alarmIndex )
 
 
 /**
- * Writes to the TIMER_ARMED register to disarm the alarm indicated by the 'alarmIndex'.
- * @param alarmIndex: Index of Alarm to be checked, must be within range [0:3].
+ * Checks all four alarms at once. ARMED is read before INTR: a match between the two reads clears ARMED after it was
+ * read and sets INTR before it is read, so the alarm shows in both bitmaps rather than in neither.
+ * @param snapshot: Receives the alarm state bitmaps.
+ * @param acknowledge: Non-zero to clear the interrupt of every alarm reported as fired.
  *
  * @return 
  *         0: 'E_OK' if successful 
  *         2: 'E_PARAM' if the input parameter is not valid 
  *
  * @pre n/a
- * @post n/a
+ * @post With 'acknowledge', the fired alarms no longer raise an interrupt.
  * @invariant n/a
  *
  */
-Std_ErrorCode Timer_RP2040_DisarmAlarmN (  uint8  alarmIndex )
+Std_ErrorCode Timer_RP2040_CheckAlarms ( tTimer_RP2040_AlarmSnapshot * snapshot, uint8 acknowledge )
 {
   Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
 
-  /* First check the alarm index is in a reasonable range */
-  if( alarmIndex > ALARM_MAX_INDEX )
+  if( NULL == snapshot )
   {
     retVal = E_INVALID_PARAM;
   }
 
   if( E_OK == retVal )
   {
-    /* The alarm index is ok, so we can write to the register */
-    *(uint32 *)TIMER_REG_ALARMn(alarmIndex) = ZERO32;
-    *TIMER_REG_ARMED &= 1 << alarmIndex;
-  }
-  
+    snapshot->armed = TIMER_REG_READ(TIMER_REG_ARMED);
+    /* Forced interrupts are known from the driver's own bookkeeping - INTF needs no read */
+    snapshot->fired = TIMER_REG_READ(TIMER_REG_INTR) | Timer_RP2040_ForcedBitmap;
+    snapshot->pending = TIMER_REG_READ(TIMER_REG_INTS);
+
+    if( (0 != acknowledge) && (ZERO32 != snapshot->fired) )
+    {
+      TIMER_REG_W1C(TIMER_REG_INTR, snapshot->fired);
+      if( ZERO32 != (snapshot->fired & Timer_RP2040_ForcedBitmap) )
+      {
+        TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+        Timer_RP2040_ForcedRelease(snapshot->fired);
+        TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+      }
+    }
+  }
+
   return retVal;
 }
 
+
 /**
  * Writes to the TIMER_ARMED register to disarm the alarm indicated by the 'alarmIndex'.
  * @param alarmIndex: Index of Alarm to be checked, must be within range [0:3].
- * @param triggerTime: 32 bit value for the alarm. The alarm will trigger when TIMER_ALARMn == TIMER_TIMELR.
  *
  * @return 
  *         0: 'E_OK' if successful 
- *         1: 'E_NOT_OK' if the operation is not successful 
  *         2: 'E_PARAM' if the input parameter is not valid 
- *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
  *
  * @pre n/a
  * @post n/a
  * @invariant n/a
  *
  */
-Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 triggerTime )
+Std_ErrorCode Timer_RP2040_DisarmAlarmN (  uint8  alarmIndex )
 {
   Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
 
   /* First check the alarm index is in a reasonable range */
   if( alarmIndex > ALARM_MAX_INDEX )
@@ -809,20 +1361,275 @@ Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 triggerTime )
     retVal = E_INVALID_PARAM;
   }
 
-  if( ZERO32 == triggerTime )
+  if( E_OK == retVal )
+  {
+    /* The alarm index is ok, so we can write to the register. Both writes must land before another core re-arms. */
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_Disarm(INT_TO_BITMAP(alarmIndex));
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+  
+  return retVal;
+}
+
+/**
+ * Arms the alarm indicated by 'alarmIndex' for 'triggerTime', forcing its interrupt if the deadline has passed by the
+ * time the write lands.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param triggerTime: 32 bit value for the alarm. The alarm will trigger when TIMER_ALARMn == TIMER_TIMELR.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre 'triggerTime' is less than 2^31 us from the current time.
+ * @post The alarm is armed, or its interrupt is pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 triggerTime )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+
+  /* First check the alarm index is in a reasonable range */
+  if( alarmIndex > ALARM_MAX_INDEX )
   {
     retVal = E_INVALID_PARAM;
   }
 
   if( E_OK == retVal )
   {
-    /* The alarm index is ok, so we can write to the register */
-    *TIMER_REG_ALARMn(alarmIndex) = triggerTime;
+    /* The alarm index is ok, so we can write to the register. Serialized against DisarmAlarmN on the other core. */
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    if( 0 != Timer_RP2040_ArmChecked(alarmIndex, triggerTime) )
+    {
+      Timer_RP2040_ForceExpired(INT_TO_BITMAP(alarmIndex));
+    }
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
   }
   
   return retVal;
 }
 
+/**
+ * Arms the alarm indicated by 'alarmIndex' for 'triggerTime', reporting a passed deadline instead of forcing the
+ * interrupt.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param triggerTime: 32 bit value for the alarm.
+ *
+ * @return 
+ *         1: 'TIMER_RP2040_ALARM_SET_NOT_TRIGGERED' if the alarm is armed
+ *         3: 'TIMER_RP2040_ALARM_EXPIRED' if the deadline had already passed - the alarm is disarmed
+ *         0xFF: 'TIMER_RP2040_ALARM_FAILED' if the input parameter is not valid
+ *
+ * @pre 'triggerTime' is less than 2^31 us from the current time.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+tTimer_RP2040_AlarmStatus Timer_RP2040_TryArmAlarmN ( uint8 alarmIndex, uint32 triggerTime )
+{
+  tTimer_RP2040_AlarmStatus retVal = TIMER_RP2040_ALARM_FAILED;
+  uint32 lockState;
+
+  if( alarmIndex <= ALARM_MAX_INDEX )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    retVal = (0 != Timer_RP2040_ArmChecked(alarmIndex, triggerTime)) ? TIMER_RP2040_ALARM_EXPIRED
+                                                                     : TIMER_RP2040_ALARM_SET_NOT_TRIGGERED;
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+
+  return retVal;
+}
+
+/**
+ * Arms the alarm indicated by 'alarmIndex' for 'delta' microseconds from now. The time is read and the comparator
+ * written in one critical section, so that the deadline is not pushed back by a preemption between the two.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param delta: Microseconds from now, must be below TIMER_RP2040_HALF_RANGE32.
+ * @param triggerTime: Receives the 32 bit deadline written to the comparator, may be NULL.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm is armed, or its interrupt is pending when the deadline passed before the write landed.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ArmAlarmRelative ( uint8 alarmIndex, uint32 delta, uint32 * triggerTime )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+  uint32 deadline;
+
+  if( (alarmIndex > ALARM_MAX_INDEX) || (delta >= TIMER_RP2040_HALF_RANGE32) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    deadline = Timer_RP2040_RawNow32() + delta;
+    if( 0 != Timer_RP2040_ArmChecked(alarmIndex, deadline) )
+    {
+      Timer_RP2040_ForceExpired(INT_TO_BITMAP(alarmIndex));
+    }
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+    if( NULL != triggerTime )
+    {
+      *triggerTime = deadline;
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Arms every alarm in 'alarmBitmap' in one critical section, for alarms which must fire in lockstep. The comparators
+ * are written back to back, then the time and ARMED are read once for all of them: the alarms whose deadline had
+ * already passed are disarmed with a single ARMED write and their interrupts are forced together. Interrupts forced
+ * for the previous deadlines are released before the comparators are written.
+ * @param alarmBitmap: Alarms to arm, bit n for alarm n. Must be non-zero and within TIMER_RP2040_ALLALARMS_BITMASK.
+ * @param triggerTimes: 32 bit values indexed by alarm index - only the entries of the alarms in 'alarmBitmap' are
+ *                      read.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *
+ * @pre Each used 'triggerTimes' entry is less than 2^31 us from the current time.
+ * @post The alarms are armed, or their interrupts are pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ArmAlarms ( uint32 alarmBitmap, const uint32 * triggerTimes )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+  uint32 remaining;
+  uint32 armed;
+  uint32 missed;
+  uint32 now;
+  uint8 alarmIndex;
+
+  if( (ZERO32 == alarmBitmap) || (ZERO32 != (alarmBitmap & ~TIMER_RP2040_ALLALARMS_BITMASK)) ||
+      (NULL == triggerTimes) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_ParkedBitmap &= ~alarmBitmap;
+    Timer_RP2040_ForcedRelease(alarmBitmap);
+    for( remaining = alarmBitmap; ZERO32 != remaining; remaining &= remaining - 1uL )
+    {
+      alarmIndex = TIMER_RP2040_CTZ(remaining);
+      TIMER_RP2040_ALARM_STORE(alarmIndex, triggerTimes[alarmIndex]);
+    }
+
+    /* The time is read before ARMED: a match up to that time has cleared the bit by then */
+    now = Timer_RP2040_RawNow32();
+    armed = TIMER_REG_READ(TIMER_REG_ARMED) & alarmBitmap;
+    missed = ZERO32;
+    for( remaining = armed; ZERO32 != remaining; remaining &= remaining - 1uL )
+    {
+      alarmIndex = TIMER_RP2040_CTZ(remaining);
+      if( (uint32)(now - triggerTimes[alarmIndex]) < TIMER_RP2040_HALF_RANGE32 )
+      {
+        missed |= INT_TO_BITMAP(alarmIndex);
+      }
+    }
+
+    if( ZERO32 != missed )
+    {
+      TIMER_REG_W1C(TIMER_REG_ARMED, missed);
+      Timer_RP2040_ForceExpired(missed);
+    }
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+
+  return retVal;
+}
+
+/**
+ * Disarms every alarm in 'alarmBitmap' with a single ARMED write.
+ * @param alarmBitmap: Alarms to disarm, bit n for alarm n. Must be non-zero and within
+ *                     TIMER_RP2040_ALLALARMS_BITMASK.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarms are disarmed and none of their interrupts is forced.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DisarmAlarms ( uint32 alarmBitmap )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+
+  if( (ZERO32 == alarmBitmap) || (ZERO32 != (alarmBitmap & ~TIMER_RP2040_ALLALARMS_BITMASK)) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_Disarm(alarmBitmap);
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+
+  return retVal;
+}
+
+/**
+ * Arms the alarm indicated by 'alarmIndex' for a 64 bit absolute deadline. The comparator is armed directly when the
+ * deadline is inside the 32 bit window, otherwise the deadline is parked behind intermediate wakes.
+ * @param alarmIndex: Index of Alarm to be armed, must be within range [0:3].
+ * @param deadline: Absolute time in microseconds.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm is armed for the deadline or for an intermediate wake, or its interrupt is pending when the deadline
+ *       has passed.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ArmAlarmAt64 ( uint8 alarmIndex, uint64 deadline )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+
+  if( alarmIndex > ALARM_MAX_INDEX )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_Deadline64[alarmIndex] = deadline;
+    Timer_RP2040_ArmWindow(alarmIndex, Timer_RP2040_RawNow64());
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+
+  return retVal;
+}
+
 /**
  * Clear timer interrupt N
  * @param interruptIndex: Index of the interrupt to be cleared (0:3)
@@ -836,6 +1643,7 @@ Std_ErrorCode Timer_RP2040_ArmAlarmN (  uint8  alarmIndex, uint32 triggerTime )
 Std_ErrorCode Timer_RP2040_InterruptClearN( uint8 interruptIndex )
 {
   Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
   if(interruptIndex > ALARM_MAX_INDEX)
   {
     retVal = E_INVALID_PARAM;
@@ -843,10 +1651,390 @@ Std_ErrorCode Timer_RP2040_InterruptClearN( uint8 interruptIndex )
 
   if(E_OK == retVal)
   {
-    *TIMER_REG_INTR = (*TIMER_REG_INTR | INT_TO_BITMAP(interruptIndex));
+    /* INTR is write-1-to-clear: writing back a read value would also clear every other pending interrupt */
+    TIMER_REG_W1C(TIMER_REG_INTR, INT_TO_BITMAP(interruptIndex));
+    if( ZERO32 != (Timer_RP2040_ForcedBitmap & INT_TO_BITMAP(interruptIndex)) )
+    {
+      TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+      Timer_RP2040_ForcedRelease(INT_TO_BITMAP(interruptIndex));
+      TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Registers the callback executed by Timer_RP2040_IrqHandler for alarm 'alarmIndex'. The bitmap is updated last when
+ * registering and first when removing, so the handler never sees a set bit without a callback behind it.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param callback: Function called when the alarm interrupt is serviced, or NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm interrupt is serviced by the callback (or left pending if the callback is NULL).
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_RegisterCallback ( uint8 alarmIndex, tTimer_RP2040_AlarmCallback callback,
+                                              void * context )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+
+  if( alarmIndex > ALARM_MAX_INDEX )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    if( NULL == callback )
+    {
+      Timer_RP2040_CallbackBitmap &= ~INT_TO_BITMAP(alarmIndex);
+      Timer_RP2040_Callback[alarmIndex] = NULL;
+      Timer_RP2040_CallbackContext[alarmIndex] = NULL;
+    }
+    else
+    {
+      Timer_RP2040_Callback[alarmIndex] = callback;
+      Timer_RP2040_CallbackContext[alarmIndex] = context;
+      Timer_RP2040_CallbackBitmap |= INT_TO_BITMAP(alarmIndex);
+    }
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  }
+
+  return retVal;
+}
+
+/**
+ * TIMER_IRQ entry point. The serviced flags are acknowledged before any callback runs, so an alarm re-armed by its
+ * own callback that fires straight away raises a new interrupt instead of being cleared with the old one. TIMER_IRQ
+ * is level sensitive: every pending flag is acknowledged, also those of alarms without a callback, and forced ones
+ * are withdrawn from INTF, or the handler would be re-entered at once. The intermediate wakes of parked 64 bit
+ * deadlines are serviced here too and never reach the callback. An alarm which expires without a callback is handed
+ * over to polling: its interrupt is disabled and the expiry kept as a forced flag for Timer_RP2040_CheckAlarmN.
+ *
+ * @return 
+ *         n/a
+ *
+ * @pre n/a
+ * @post Alarm interrupts which were pending are cleared.
+ * @invariant n/a
+ *
+ */
+void Timer_RP2040_IrqHandler ( void )
+{
+  uint32 pending;
+  uint8 alarmIndex;
+
+  uint32 parked;
+  uint32 forced;
+  uint32 orphaned;
+  uint32 lockState;
+  tTimer_RP2040_AlarmCallback callback;
+  void * context;
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+  uint32 measured;
+#endif
+
+  pending = TIMER_REG_READ(TIMER_REG_INTS);
+
+  if( ZERO32 != pending )
+  {
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+    /* Only a comparator match or a missed deadline has an ALARMn value to measure against, a trigger has none */
+    measured = pending & (TIMER_REG_READ(TIMER_REG_INTR) | Timer_RP2040_ForcedBitmap);
+#endif
+    TIMER_REG_W1C(TIMER_REG_INTR, pending);
+    /* Forced by the driver or through Timer_RP2040_InterruptNTrigger - either way taken once */
+    forced = TIMER_REG_READ(TIMER_REG_INTF) & pending;
+    if( ZERO32 != forced )
+    {
+      TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+      Timer_RP2040_ForcedBitmap &= ~forced;
+      TIMER_REG_CLR(TIMER_REG_INTF, forced);
+      TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    }
+
+    parked = pending & Timer_RP2040_ParkedBitmap;
+    while( ZERO32 != parked )
+    {
+      alarmIndex = TIMER_RP2040_CTZ(parked);
+      parked &= parked - 1uL;
+      if( 0 == Timer_RP2040_ParkedWake(alarmIndex) )
+      {
+        pending &= ~INT_TO_BITMAP(alarmIndex);
+      }
+    }
+
+    orphaned = pending & ~Timer_RP2040_CallbackBitmap;
+    if( ZERO32 != orphaned )
+    {
+      /* Disabled before it is forced, so the kept expiry does not raise the interrupt again */
+      TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+#if ( TIMER_RP2040_SHADOW != 0 )
+      Timer_RP2040_ShadowInte &= ~orphaned;
+#endif
+      TIMER_REG_CLR(TIMER_REG_INTE, orphaned);
+      Timer_RP2040_ForceExpired(orphaned);
+      TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    }
+
+    pending &= ~orphaned;
+    while( ZERO32 != pending )
+    {
+      alarmIndex = TIMER_RP2040_CTZ(pending);
+      pending &= pending - 1uL;
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+      if( ZERO32 != (measured & INT_TO_BITMAP(alarmIndex)) )
+      {
+        Timer_RP2040_LatencyRecord(alarmIndex);
+      }
+#endif
+      /* The pair is copied under the lock - the other core may replace or remove the registration meanwhile */
+      TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+      callback = Timer_RP2040_Callback[alarmIndex];
+      context = Timer_RP2040_CallbackContext[alarmIndex];
+      TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+      if( NULL != callback )
+      {
+        callback(alarmIndex, context);
+      }
+    }
+  }
+}
+
+/**
+ * Starts a drift-free periodic alarm. The first deadline is one period from now, every following deadline is exactly
+ * one period after the previous one. 'callback' runs from Timer_RP2040_IrqHandler once per period, after the alarm
+ * has been re-armed. Replaces any callback registered for the alarm.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param period: Period in microseconds, must be within range [1:2^31 - 1].
+ * @param callback: Function called once per period, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The alarm is armed one period from now.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_PeriodicStart ( uint8 alarmIndex, uint32 period, tTimer_RP2040_AlarmCallback callback,
+                                           void * context )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_Periodic * periodic;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_Status )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+  else if( (alarmIndex > ALARM_MAX_INDEX) || (NULL == callback) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else if( (ZERO32 == period) || (period >= TIMER_RP2040_HALF_RANGE32) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else
+  {
+    /* Detach the old callback first, so a pending interrupt does not see a half written state */
+    retVal = Timer_RP2040_RegisterCallback(alarmIndex, NULL, NULL);
+  }
+
+  if( E_OK == retVal )
+  {
+    periodic = &Timer_RP2040_Periodic[alarmIndex];
+    periodic->period = period;
+    periodic->skipped = ZERO32;
+    periodic->callback = callback;
+    periodic->context = context;
+    periodic->deadline = Timer_RP2040_RawNow32() + period;
+    periodic->active = 1;
+
+    retVal = Timer_RP2040_RegisterCallback(alarmIndex, Timer_RP2040_PeriodicIrq, periodic);
+  }
+
+  if( E_OK == retVal )
+  {
+    (void)Timer_RP2040_PeriodicArm(alarmIndex, Timer_RP2040_Periodic[alarmIndex].deadline);
+  }
+
+  return retVal;
+}
+
+/**
+ * Stops a periodic alarm. The alarm is marked stopped, disarmed and its interrupt withdrawn in one critical section,
+ * so a handler already running on the other core does not re-arm it. The callback is removed last.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre n/a
+ * @post The alarm is disarmed, its interrupt is not pending and it has no callback.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_PeriodicStop ( uint8 alarmIndex )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 lockState;
+
+  if( alarmIndex > ALARM_MAX_INDEX )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+    Timer_RP2040_Periodic[alarmIndex].active = 0;
+    Timer_RP2040_Disarm(INT_TO_BITMAP(alarmIndex));
+    /* A period which matched just before is withdrawn too - there is no callback left to take it */
+    TIMER_REG_W1C(TIMER_REG_INTR, INT_TO_BITMAP(alarmIndex));
+    TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+    retVal = Timer_RP2040_RegisterCallback(alarmIndex, NULL, NULL);
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports the number of periods a periodic alarm has skipped because its interrupt was serviced too late.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         Skipped periods since Timer_RP2040_PeriodicStart, 0 for an invalid index.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_PeriodicSkipped ( uint8 alarmIndex )
+{
+  uint32 skipped = ZERO32;
+
+  if( alarmIndex <= ALARM_MAX_INDEX )
+  {
+    skipped = Timer_RP2040_Periodic[alarmIndex].skipped;
+  }
+
+  return skipped;
+}
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/**
+ * Copies the interrupt latency statistics of alarm 'alarmIndex'. The copy is retried while the handler is updating
+ * the statistics, so it never mixes two updates.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ * @param stats: Receives the statistics.
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if an input parameter is not valid 
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_LatencySnapshot ( uint8 alarmIndex, tTimer_RP2040_LatencyStats * stats )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_Latency * latency;
+  uint32 sequence;
+  uint8 bucket;
+
+  if( (alarmIndex > ALARM_MAX_INDEX) || (NULL == stats) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    latency = &Timer_RP2040_Latency[alarmIndex];
+    do
+    {
+      sequence = latency->sequence;
+      TIMER_RP2040_MEMORY_BARRIER();
+
+      stats->count = latency->count;
+      stats->min = latency->min;
+      stats->max = latency->max;
+      stats->sum = latency->sum;
+      for( bucket = 0; bucket < TIMER_RP2040_LATENCY_BUCKETS; bucket++ )
+      {
+        stats->bucket[bucket] = latency->bucket[bucket];
+      }
+
+      TIMER_RP2040_MEMORY_BARRIER();
+    } while( (0 != (sequence & 1uL)) || (sequence != latency->sequence) );
+
+    stats->mean = (ZERO32 != stats->count) ? (uint32)(stats->sum / stats->count) : ZERO32;
   }
 
   return retVal;
 }
 
+/**
+ * Clears the interrupt latency statistics of alarm 'alarmIndex'.
+ * @param alarmIndex: Index of the alarm, must be within range [0:3].
+ *
+ * @return 
+ *         0: 'E_OK' if successful 
+ *         2: 'E_PARAM' if the input parameter is not valid 
+ *
+ * @pre The alarm interrupt does not fire during the reset.
+ * @post No latency is recorded for the alarm.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_LatencyReset ( uint8 alarmIndex )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_Latency * latency;
+  uint8 bucket;
+
+  if( alarmIndex > ALARM_MAX_INDEX )
+  {
+    retVal = E_INVALID_PARAM;
+  }
 
+  if( E_OK == retVal )
+  {
+    latency = &Timer_RP2040_Latency[alarmIndex];
+    latency->sequence++;
+    TIMER_RP2040_MEMORY_BARRIER();
+
+    latency->count = ZERO32;
+    latency->min = ZERO32;
+    latency->max = ZERO32;
+    latency->sum = 0;
+    for( bucket = 0; bucket < TIMER_RP2040_LATENCY_BUCKETS; bucket++ )
+    {
+      latency->bucket[bucket] = ZERO32;
+    }
+
+    TIMER_RP2040_MEMORY_BARRIER();
+    latency->sequence++;
+  }
+
+  return retVal;
+}
+#endif
@@ -0,0 +1,143 @@
+/**
+ *
+* @file "Timer_RP2040_Conv.c"
+* @author Madrick3
+* @brief 64 bit time unit conversions, see Timer_RP2040_Conv.h.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.02.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-015   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-017   |  64 by 32 bit division for a variable divisor
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Limb width of the 64 bit division - the remainder times 2^16 plus a limb stays below 2^32 for divisors < 2^16 */
+#define TIMER_RP2040_CONV_LIMB_BITS  16
+#define TIMER_RP2040_CONV_LIMB_MASK  0xFFFFuL
+#define TIMER_RP2040_CONV_LIMB_COUNT 4
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Conv.h"
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Divides a 64 bit value by 1000 with four 32 bit divisions, most significant limb first.
+ * @param value: Dividend.
+ *
+ * @return 
+ *         floor(value / 1000).
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_ConvDiv1000 ( uint64 value )
+{
+  uint64 quotient = 0;
+  uint32 remainder = ZERO32;
+  uint32 partial;
+  uint32 digit;
+  uint8 limb;
+
+  for( limb = TIMER_RP2040_CONV_LIMB_COUNT; limb > 0; limb-- )
+  {
+    partial = (remainder << TIMER_RP2040_CONV_LIMB_BITS) |
+              ((uint32)(value >> ((limb - 1) * TIMER_RP2040_CONV_LIMB_BITS)) & TIMER_RP2040_CONV_LIMB_MASK);
+    digit = TIMER_RP2040_CONV_DIV(partial, 1000uL, TIMER_RP2040_CONV_RECIP_1000, TIMER_RP2040_CONV_SHIFT_1000);
+    remainder = partial - (digit * 1000uL);
+    quotient = (quotient << TIMER_RP2040_CONV_LIMB_BITS) | digit;
+  }
+
+  return quotient;
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Converts 64 bit microseconds to milliseconds, rounding down.
+ * @param us: Microseconds.
+ *
+ * @return 
+ *         Milliseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_Us64ToMs ( uint64 us )
+{
+  return Timer_RP2040_ConvDiv1000(us);
+}
+
+/**
+ * Converts 64 bit microseconds to seconds, rounding down. Two divisions by 1000 give the same result as one by
+ * 1000000, and keep the limbs within the 32 bit fast path.
+ * @param us: Microseconds.
+ *
+ * @return 
+ *         Seconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_Us64ToS ( uint64 us )
+{
+  return Timer_RP2040_ConvDiv1000(Timer_RP2040_ConvDiv1000(us));
+}
+
+/**
+ * Unsigned 64 by 32 bit division by restoring binary long division. Only 32 bit compares and subtractions and
+ * 64 bit shifts by one are used, none of which calls into libgcc on the Cortex-M0+. The remainder may need 33 bits
+ * after the shift; the bit shifted out is kept in carry, and the subtraction modulo 2^32 is then still exact.
+ * @param dividend: Value to divide.
+ * @param divisor: Non-zero divisor.
+ *
+ * @return 
+ *         floor(dividend / divisor).
+ *
+ * @pre divisor != 0
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_UDiv64 ( uint64 dividend, uint32 divisor )
+{
+  uint64 quotient = 0;
+  uint32 remainder = 0;
+  uint32 carry;
+  uint8 bit;
+
+  for( bit = 64; bit > 0; bit-- )
+  {
+    carry = remainder >> 31;
+    remainder = (remainder << 1) | (uint32)(dividend >> 63);
+    dividend <<= 1;
+    quotient <<= 1;
+    if( ( ZERO32 != carry ) || ( remainder >= divisor ) )
+    {
+      remainder -= divisor;
+      quotient |= 1;
+    }
+  }
+
+  return quotient;
+}
@@ -0,0 +1,240 @@
+/**
+ *
+* @file "Timer_RP2040_Defer.c"
+* @author Madrick3
+* @brief Lock-free single-producer / single-consumer deferred work queue for the RP2040 timer. Head and tail are free
+* running counters, the slot is the counter masked with TIMER_RP2040_DEFER_MASK, and the fill level is tail - head.
+* Each side publishes its counter only after a memory barrier, so the other side never sees an index move before the
+* slot contents it covers.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-006   |  Initial Creation
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Defer.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Compile time check that the capacity is a power of two */
+typedef uint8 tTimer_RP2040_DeferCapacityCheck[((TIMER_RP2040_DEFER_CAPACITY & TIMER_RP2040_DEFER_MASK) == 0) ? 1 : -1];
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+TIMER_RP2040_LOCAL tTimer_RP2040_Status Timer_RP2040_DeferStatus = TIMER_RP2040_UNINIT;
+
+TIMER_RP2040_LOCAL tTimer_RP2040_DeferEntry Timer_RP2040_DeferRing[TIMER_RP2040_DEFER_CAPACITY];
+
+/* Next entry to consume - only written by the consumer */
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_DeferHead = ZERO32;
+
+/* Next free entry - only written by the producer */
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_DeferTail = ZERO32;
+
+/* Entries dropped because the ring was full - only written by the producer */
+TIMER_RP2040_LOCAL volatile uint32 Timer_RP2040_DeferDropCount = ZERO32;
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the deferred work queue, dropping any queued entries.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The queue is empty.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DeferInit ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    Timer_RP2040_DeferHead = ZERO32;
+    Timer_RP2040_DeferTail = ZERO32;
+    Timer_RP2040_DeferDropCount = ZERO32;
+    TIMER_RP2040_MEMORY_BARRIER();
+    Timer_RP2040_DeferStatus = TIMER_RP2040_INIT;
+  }
+
+  return retVal;
+}
+
+/**
+ * Queues 'function' to be called with 'context' by the consumer. The slot is filled first, and the tail published
+ * after the barrier.
+ * @param function: Function to run, may not be NULL.
+ * @param context: Passed to the function untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the queue is full - the entry is dropped and counted
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the queue is not yet initialized
+ *
+ * @pre Queue was previously initialized.
+ * @post The entry is visible to the consumer.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DeferPost ( tTimer_RP2040_DeferFunction function, void * context )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 tail;
+  tTimer_RP2040_DeferEntry * entry;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_DeferStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+  else if( NULL == function )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else
+  {
+    tail = Timer_RP2040_DeferTail;
+
+    if( (uint32)(tail - Timer_RP2040_DeferHead) >= TIMER_RP2040_DEFER_CAPACITY )
+    {
+      Timer_RP2040_DeferDropCount = Timer_RP2040_DeferDropCount + 1uL;
+      retVal = E_NOT_OK;
+    }
+    else
+    {
+      /* The consumer's head read above must complete before the slot it frees is overwritten */
+      TIMER_RP2040_MEMORY_BARRIER();
+      entry = &Timer_RP2040_DeferRing[tail & TIMER_RP2040_DEFER_MASK];
+      entry->function = function;
+      entry->context = context;
+      entry->timestamp = Timer_RP2040_RawNow32();
+      TIMER_RP2040_MEMORY_BARRIER();
+      Timer_RP2040_DeferTail = tail + 1uL;
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Removes the oldest entry from the queue without running it. The slot is copied out first, and the head published
+ * after the barrier.
+ * @param entry: Receives the oldest entry.
+ *
+ * @return
+ *         0: 'E_OK' if an entry was removed
+ *         1: 'E_NOT_OK' if the queue is empty
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the queue is not yet initialized
+ *
+ * @pre Queue was previously initialized.
+ * @post The slot is free for the producer.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DeferPop ( tTimer_RP2040_DeferEntry * entry )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 head;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_DeferStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+  else if( NULL == entry )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else
+  {
+    head = Timer_RP2040_DeferHead;
+
+    if( head == Timer_RP2040_DeferTail )
+    {
+      retVal = E_NOT_OK;
+    }
+    else
+    {
+      /* The producer's tail read above must complete before the slot it covers is read */
+      TIMER_RP2040_MEMORY_BARRIER();
+      *entry = Timer_RP2040_DeferRing[head & TIMER_RP2040_DEFER_MASK];
+      TIMER_RP2040_MEMORY_BARRIER();
+      Timer_RP2040_DeferHead = head + 1uL;
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Runs queued entries, oldest first. Each entry is popped before it runs, so a function may post new work.
+ * @param maxEntries: Upper bound on the number of entries run in this call.
+ *
+ * @return
+ *         Number of entries run.
+ *
+ * @pre Queue was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_DeferProcess ( uint32 maxEntries )
+{
+  uint32 count = ZERO32;
+  tTimer_RP2040_DeferEntry entry;
+
+  while( (count < maxEntries) && (E_OK == Timer_RP2040_DeferPop(&entry)) )
+  {
+    entry.function(entry.context, entry.timestamp);
+    count++;
+  }
+
+  return count;
+}
+
+/**
+ * Reports the number of entries dropped by Timer_RP2040_DeferPost because the queue was full.
+ *
+ * @return
+ *         Dropped entries since Timer_RP2040_DeferInit.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_DeferDropped ( void )
+{
+  return Timer_RP2040_DeferDropCount;
+}
@@ -0,0 +1,189 @@
+/**
+ *
+* @file "Timer_RP2040_Delay.c"
+* @author Madrick3
+* @brief Blocking delays - a spin on TIMERAWL for short waits, a sleep on the reserved alarm for long ones.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-024   |  Initial Creation
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Delay.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Compile time check that a sleeping delay wakes after it was armed */
+typedef uint8 tTimer_RP2040_DelayWakeCheck[(TIMER_RP2040_DELAY_WAKE_US < TIMER_RP2040_DELAY_SLEEP_US) ? 1 : -1];
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+TIMER_RP2040_LOCAL tTimer_RP2040_Status Timer_RP2040_DelayStatus = TIMER_RP2040_UNINIT;
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Callback of the delay alarm. The interrupt has been acknowledged by Timer_RP2040_IrqHandler, and taking it has
+ * ended the sleep - there is nothing left to do.
+ * @param alarmIndex: Unused.
+ * @param context: Unused.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_DelayWake ( uint8 alarmIndex, void * context )
+{
+  (void)alarmIndex;
+  (void)context;
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Reserves the delay alarm for sleeping delays.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The delay alarm interrupt is enabled and serviced.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DelayInit ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  /* The callback is registered while the interrupt is still disabled */
+  if( E_OK == retVal )
+  {
+    retVal = Timer_RP2040_RegisterCallback(TIMER_RP2040_DELAY_ALARM, Timer_RP2040_DelayWake, NULL);
+  }
+
+  if( E_OK == retVal )
+  {
+    retVal = Timer_RP2040_InterruptEnable(INT_TO_BITMAP(TIMER_RP2040_DELAY_ALARM));
+  }
+
+  if( E_OK == retVal )
+  {
+    Timer_RP2040_DelayStatus = TIMER_RP2040_INIT;
+  }
+
+  return retVal;
+}
+
+/**
+ * Waits 'delay' microseconds. The start time is read before the checks, so that they count towards the delay.
+ * @param delay: Microseconds to wait, must be below TIMER_RP2040_HALF_RANGE32.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre The timer is not paused.
+ * @post At least 'delay' microseconds have passed.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DelayUs ( uint32 delay )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 start = Timer_RP2040_RawNow32();
+
+  if( delay >= TIMER_RP2040_HALF_RANGE32 )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    retVal = Timer_RP2040_DelayUntil(start + delay);
+  }
+
+  return retVal;
+}
+
+/**
+ * Waits until TIMERAWL reaches 'deadline'. A long wait sleeps until TIMER_RP2040_DELAY_WAKE_US before the deadline.
+ * Should the wake time pass before the alarm is armed, Timer_RP2040_ArmAlarmN forces the interrupt, so the sleep
+ * cannot miss its wake-up. The remainder is spun in either case.
+ * @param deadline: Absolute 32 bit time.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre The timer is not paused.
+ * @post The deadline has passed.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_DelayUntil ( uint32 deadline )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 remaining;
+  uint32 wake;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    remaining = deadline - Timer_RP2040_RawNow32();
+
+    if( (TIMER_RP2040_INIT == Timer_RP2040_DelayStatus) && (remaining > TIMER_RP2040_DELAY_SLEEP_US) &&
+        (remaining < TIMER_RP2040_HALF_RANGE32) )
+    {
+      wake = deadline - TIMER_RP2040_DELAY_WAKE_US;
+      (void)Timer_RP2040_ArmAlarmN(TIMER_RP2040_DELAY_ALARM, wake);
+
+      while( (uint32)(Timer_RP2040_RawNow32() - wake) >= TIMER_RP2040_HALF_RANGE32 )
+      {
+        TIMER_RP2040_DELAY_SLEEP();
+      }
+    }
+
+    while( (uint32)(Timer_RP2040_RawNow32() - deadline) >= TIMER_RP2040_HALF_RANGE32 )
+    {
+      TIMER_RP2040_DELAY_SPIN();
+    }
+  }
+
+  return retVal;
+}
@@ -0,0 +1,292 @@
+/**
+ *
+* @file "Timer_RP2040_Prof.c"
+* @author Madrick3
+* @brief Code section profiling - site storage, read back and the table dump. The markers themselves are inline in
+* Timer_RP2040_Prof.h.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-017   |  Initial Creation
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Digits of the largest uint64 value */
+#define TIMER_RP2040_PROF_DIGITS_MAX 20u
+
+/* Column widths of the dump table */
+#define TIMER_RP2040_PROF_WIDTH_SITE  4u
+#define TIMER_RP2040_PROF_WIDTH_COUNT 10u
+#define TIMER_RP2040_PROF_WIDTH_TOTAL 16u
+#define TIMER_RP2040_PROF_WIDTH_TIME  9u
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Prof.h"
+#include "Timer_RP2040_Conv.h"
+
+/************************************************************
+  GLOBAL VARIABLES
+************************************************************/
+tTimer_RP2040_ProfSite Timer_RP2040_ProfSite[TIMER_RP2040_PROF_SITES];
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Formats 'value' in decimal, three digits at a time so that only divisions by constants are needed.
+ * @param text: Receives up to TIMER_RP2040_PROF_DIGITS_MAX digits and the terminating zero.
+ * @param value: Value to format.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_ProfDecimal ( char * text, uint64 value )
+{
+  char digits[TIMER_RP2040_PROF_DIGITS_MAX + 2u];
+  uint8 count = 0;
+  uint8 digit;
+  uint64 thousands;
+  uint32 group;
+  uint32 tens;
+
+  do
+  {
+    /* value / 1000 */
+    thousands = Timer_RP2040_Us64ToMs(value);
+    group = (uint32)(value - (thousands * 1000uL));
+    for( digit = 0; digit < 3u; digit++ )
+    {
+      tens = TIMER_RP2040_CONV_DIV(group, 10uL, TIMER_RP2040_CONV_RECIP_10, TIMER_RP2040_CONV_SHIFT_10);
+      digits[count] = (char)('0' + (group - (tens * 10uL)));
+      count++;
+      group = tens;
+    }
+    value = thousands;
+  } while( 0 != value );
+
+  /* Drop the leading zeros of the last group */
+  while( (count > 1u) && ('0' == digits[count - 1u]) )
+  {
+    count--;
+  }
+
+  for( digit = 0; digit < count; digit++ )
+  {
+    text[digit] = digits[count - 1u - digit];
+  }
+  text[count] = '\0';
+}
+
+/**
+ * Appends 'text' right aligned in a column of 'width' characters, preceded by a space unless it is the first column.
+ * @param line: Line being built.
+ * @param length: Current length of the line, advanced past the column.
+ * @param text: Zero terminated column text.
+ * @param width: Column width - longer text is not cut.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre The line has room for the column.
+ * @post The line is zero terminated.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_ProfColumn ( char * line, uint8 * length, const char * text, uint8 width )
+{
+  uint8 textLength = 0;
+  uint8 i;
+
+  while( '\0' != text[textLength] )
+  {
+    textLength++;
+  }
+
+  if( 0u != *length )
+  {
+    line[*length] = ' ';
+    (*length)++;
+  }
+  for( i = textLength; i < width; i++ )
+  {
+    line[*length] = ' ';
+    (*length)++;
+  }
+  for( i = 0; i < textLength; i++ )
+  {
+    line[*length] = text[i];
+    (*length)++;
+  }
+  line[*length] = '\0';
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Clears the accumulators of every site. The minimum starts at its largest value, so that the markers need no
+ * first-call check.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled. No section is being profiled.
+ * @post Every site reports a count of 0.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ProfInit ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint8 site;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    for( site = 0; site < TIMER_RP2040_PROF_SITES; site++ )
+    {
+      Timer_RP2040_ProfSite[site].start = ZERO32;
+      Timer_RP2040_ProfSite[site].count = ZERO32;
+      Timer_RP2040_ProfSite[site].min = 0xFFFFFFFFuL;
+      Timer_RP2040_ProfSite[site].max = ZERO32;
+      Timer_RP2040_ProfSite[site].total = 0;
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Reads the statistics of one site.
+ * @param site: Site id, must be below TIMER_RP2040_PROF_SITES.
+ * @param stats: Receives the statistics.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *
+ * @pre Profiling was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ProfRead ( uint8 site, tTimer_RP2040_ProfStats * stats )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_ProfSite * entry;
+
+  if( (site >= TIMER_RP2040_PROF_SITES) || (NULL == stats) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    entry = &Timer_RP2040_ProfSite[site];
+    stats->count = entry->count;
+    stats->total = entry->total;
+
+    if( ZERO32 != stats->count )
+    {
+      stats->min = entry->min;
+      stats->max = entry->max;
+      stats->mean = (uint32)Timer_RP2040_UDiv64(stats->total, stats->count);
+    }
+    else
+    {
+      stats->min = ZERO32;
+      stats->max = ZERO32;
+      stats->mean = ZERO32;
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Writes the statistics of every used site as a table.
+ * @param output: Receives each line.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *
+ * @pre Profiling was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_ProfDump ( tTimer_RP2040_ProfOutput output )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_ProfStats stats;
+  char line[TIMER_RP2040_PROF_LINE_MAX];
+  char number[TIMER_RP2040_PROF_DIGITS_MAX + 1u];
+  uint8 length;
+  uint8 site;
+
+  if( NULL == output )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    length = 0;
+    Timer_RP2040_ProfColumn(line, &length, "site", TIMER_RP2040_PROF_WIDTH_SITE);
+    Timer_RP2040_ProfColumn(line, &length, "count", TIMER_RP2040_PROF_WIDTH_COUNT);
+    Timer_RP2040_ProfColumn(line, &length, "total_us", TIMER_RP2040_PROF_WIDTH_TOTAL);
+    Timer_RP2040_ProfColumn(line, &length, "min_us", TIMER_RP2040_PROF_WIDTH_TIME);
+    Timer_RP2040_ProfColumn(line, &length, "max_us", TIMER_RP2040_PROF_WIDTH_TIME);
+    Timer_RP2040_ProfColumn(line, &length, "mean_us", TIMER_RP2040_PROF_WIDTH_TIME);
+    output(line);
+
+    for( site = 0; site < TIMER_RP2040_PROF_SITES; site++ )
+    {
+      (void)Timer_RP2040_ProfRead(site, &stats);
+
+      if( ZERO32 != stats.count )
+      {
+        length = 0;
+        Timer_RP2040_ProfDecimal(number, site);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_SITE);
+        Timer_RP2040_ProfDecimal(number, stats.count);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_COUNT);
+        Timer_RP2040_ProfDecimal(number, stats.total);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_TOTAL);
+        Timer_RP2040_ProfDecimal(number, stats.min);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_TIME);
+        Timer_RP2040_ProfDecimal(number, stats.max);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_TIME);
+        Timer_RP2040_ProfDecimal(number, stats.mean);
+        Timer_RP2040_ProfColumn(line, &length, number, TIMER_RP2040_PROF_WIDTH_TIME);
+        output(line);
+      }
+    }
+  }
+
+  return retVal;
+}
@@ -0,0 +1,1369 @@
+/**
+ *
+* @file "Timer_RP2040_Sched.c"
+* @author Madrick3
+* @brief Software alarm multiplexer for the RP2040 timer. Two interchangeable backends are provided, selected with
+* TIMER_RP2040_SCHED_BACKEND:
+*   - HEAP: pending soft timers are kept in a binary min-heap ordered by deadline, and only the heap root is programmed
+*     into the scheduler hardware alarm. O(log n) start/stop/expire, microsecond resolution.
+*   - WHEEL: pending soft timers are hashed into a hierarchical timing wheel which is advanced by a periodic tick on
+*     the scheduler alarm. O(1) start/stop, expiry is rounded up to the next tick.
+* Both backends coalesce timers with a slack, see Timer_RP2040_SchedStartWindow.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.05.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-001   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-002   |  Hierarchical timing wheel backend
+  01.03.00 |  Madrick3 |  user-007   |  Multicore scheduler lock
+  01.04.00 |  Madrick3 |  user-009   |  Tickless idle support
+  01.05.00 |  Madrick3 |  user-019   |  Timer coalescing with slack windows
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Sched.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+TIMER_RP2040_LOCAL tTimer_RP2040_Status Timer_RP2040_SchedStatus = TIMER_RP2040_UNINIT;
+
+/* Interrupt state saved by the holder of the scheduler lock (TIMER_RP2040_MULTICORE) - only touched under the lock */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_SchedLockState = ZERO32;
+
+/* Number of pending soft timers */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_SchedCount = 0;
+
+/* Logical tick count last reported by Timer_RP2040_SchedCatchUpTicks */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedTicks = 0;
+
+/* Coalescing statistics - 'saved' is only filled in by Timer_RP2040_SchedCoalesceStats */
+TIMER_RP2040_LOCAL tTimer_RP2040_SchedStats Timer_RP2040_SchedStats;
+
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+
+/* Binary min-heap of pending timers, ordered by deadline. Index 0 is the next timer to expire. */
+TIMER_RP2040_LOCAL tTimer_RP2040_SoftTimer * Timer_RP2040_SchedHeap[TIMER_RP2040_SCHED_MAX_TIMERS];
+
+/* Time the scheduler alarm is programmed for - the end of the earliest closing window, or NO_DEADLINE if disarmed */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedWake = TIMER_RP2040_SCHED_NO_DEADLINE;
+
+#else /* TIMER_RP2040_SCHED_BACKEND_WHEEL */
+
+/* Timing wheel - level 0 holds one slot per tick, every level above covers TIMER_RP2040_SCHED_WHEEL_SLOTS times more. */
+TIMER_RP2040_LOCAL tTimer_RP2040_SoftTimer * Timer_RP2040_SchedWheel[TIMER_RP2040_SCHED_WHEEL_LEVELS][TIMER_RP2040_SCHED_WHEEL_SLOTS];
+
+/* Next tick the wheel will process */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedWheelTick = 0;
+
+#if ( TIMER_RP2040_TICKLESS != 0 )
+/* Tick the scheduler alarm is programmed for - TIMER_RP2040_SCHED_NO_DEADLINE if disarmed */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedWheelWake = TIMER_RP2040_SCHED_NO_DEADLINE;
+#endif
+
+#endif /* TIMER_RP2040_SCHED_BACKEND */
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Arms the scheduler alarm for an absolute wake time. Wakes more than TIMER_RP2040_SCHED_MAX_SLEEP_US away are parked
+ * by the driver, which serves the intermediate wakes itself.
+ * @param wake: Absolute time in microseconds.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedArm ( uint64 wake )
+{
+  return Timer_RP2040_ArmAlarmAt64(TIMER_RP2040_SCHED_ALARM_INDEX, wake);
+}
+
+/**
+ * Counts a timer expired at 'now' in the coalescing statistics.
+ * @param timer: Timer being expired.
+ * @param now: Current time in microseconds.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Called within the scheduler critical section.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedTally ( const tTimer_RP2040_SoftTimer * timer, uint64 now )
+{
+  Timer_RP2040_SchedStats.expired++;
+  if( now > timer->deadline )
+  {
+    Timer_RP2040_SchedStats.lateTotal += now - timer->deadline;
+  }
+}
+
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+
+/**
+ * Stores a timer in the heap at the given index, and updates the back-reference in the timer.
+ * @param index: Heap slot to write.
+ * @param timer: Timer to store.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedPlace ( uint32 index, tTimer_RP2040_SoftTimer * timer )
+{
+  Timer_RP2040_SchedHeap[index] = timer;
+  timer->heapSlot = index + 1;
+}
+
+/**
+ * Moves the timer at 'index' towards the root until the heap order is restored.
+ * @param index: Heap slot of the timer to move.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedSiftUp ( uint32 index )
+{
+  tTimer_RP2040_SoftTimer * timer = Timer_RP2040_SchedHeap[index];
+  uint32 parent;
+
+  while( index > 0 )
+  {
+    parent = (index - 1) / 2;
+    if( Timer_RP2040_SchedHeap[parent]->deadline <= timer->deadline )
+    {
+      break;
+    }
+    Timer_RP2040_SchedPlace(index, Timer_RP2040_SchedHeap[parent]);
+    index = parent;
+  }
+
+  Timer_RP2040_SchedPlace(index, timer);
+}
+
+/**
+ * Moves the timer at 'index' towards the leaves until the heap order is restored.
+ * @param index: Heap slot of the timer to move.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedSiftDown ( uint32 index )
+{
+  tTimer_RP2040_SoftTimer * timer = Timer_RP2040_SchedHeap[index];
+  uint32 child;
+
+  for( ;; )
+  {
+    child = (2 * index) + 1;
+    if( child >= Timer_RP2040_SchedCount )
+    {
+      break;
+    }
+    /* Pick the earlier of the two children */
+    if( ((child + 1) < Timer_RP2040_SchedCount) &&
+        (Timer_RP2040_SchedHeap[child + 1]->deadline < Timer_RP2040_SchedHeap[child]->deadline) )
+    {
+      child++;
+    }
+    if( timer->deadline <= Timer_RP2040_SchedHeap[child]->deadline )
+    {
+      break;
+    }
+    Timer_RP2040_SchedPlace(index, Timer_RP2040_SchedHeap[child]);
+    index = child;
+  }
+
+  Timer_RP2040_SchedPlace(index, timer);
+}
+
+/**
+ * Removes a pending timer from the heap.
+ * @param timer: Pending timer to remove.
+ *
+ * @pre Timer is pending.
+ * @post Timer is not pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedRemove ( tTimer_RP2040_SoftTimer * timer )
+{
+  uint32 index = timer->heapSlot - 1;
+  tTimer_RP2040_SoftTimer * last;
+
+  Timer_RP2040_SchedCount--;
+  last = Timer_RP2040_SchedHeap[Timer_RP2040_SchedCount];
+  timer->heapSlot = TIMER_RP2040_SCHED_INACTIVE;
+
+  /* Fill the hole with the last timer and restore the heap order in whichever direction is needed */
+  if( index != Timer_RP2040_SchedCount )
+  {
+    Timer_RP2040_SchedPlace(index, last);
+    if( (index > 0) && (last->deadline < Timer_RP2040_SchedHeap[(index - 1) / 2]->deadline) )
+    {
+      Timer_RP2040_SchedSiftUp(index);
+    }
+    else
+    {
+      Timer_RP2040_SchedSiftDown(index);
+    }
+  }
+}
+
+/**
+ * Finds the end of the earliest closing window among the pending timers. Only timers whose window opens before the
+ * best end found so far can close earlier, and since the heap is ordered by deadline (window opening) whole subtrees
+ * are skipped once their root opens too late. The walk therefore only visits the timers which will be expired
+ * together at the wake, plus their children - without slack that is the root and its two children.
+ *
+ * @return
+ *         Absolute time in microseconds, or TIMER_RP2040_SCHED_NO_DEADLINE if no timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedNextWake ( void )
+{
+  uint64 wake = TIMER_RP2040_SCHED_NO_DEADLINE;
+  uint64 latest;
+  uint32 index = 0;
+  uint8 descend;
+
+  while( index < Timer_RP2040_SchedCount )
+  {
+    descend = 0;
+    if( Timer_RP2040_SchedHeap[index]->deadline < wake )
+    {
+      latest = Timer_RP2040_SchedHeap[index]->deadline + Timer_RP2040_SchedHeap[index]->slack;
+      if( latest < wake )
+      {
+        wake = latest;
+      }
+      descend = 1;
+    }
+
+    if( (1 == descend) && (((2 * index) + 1) < Timer_RP2040_SchedCount) )
+    {
+      index = (2 * index) + 1;
+    }
+    else
+    {
+      /* Climb while on a right child, or a left child without a sibling, then move on to the right sibling */
+      while( (index > 0) && ((ZERO32 == (index & 1uL)) || ((index + 1) >= Timer_RP2040_SchedCount)) )
+      {
+        index = (index - 1) / 2;
+      }
+      if( 0 == index )
+      {
+        break;
+      }
+      index++;
+    }
+  }
+
+  return wake;
+}
+
+/**
+ * Programs the scheduler alarm for the end of the earliest closing window, or disarms it if nothing is pending.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedProgram ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  Timer_RP2040_SchedWake = Timer_RP2040_SchedNextWake();
+  if( TIMER_RP2040_SCHED_NO_DEADLINE == Timer_RP2040_SchedWake )
+  {
+    retVal = Timer_RP2040_DisarmAlarmN(TIMER_RP2040_SCHED_ALARM_INDEX);
+  }
+  else
+  {
+    retVal = Timer_RP2040_SchedArm(Timer_RP2040_SchedWake);
+  }
+
+  return retVal;
+}
+
+/**
+ * Drops every pending timer, and disarms the scheduler alarm.
+ * @param now: Current time in microseconds.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post No soft timer is pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedReset ( uint64 now )
+{
+  uint32 index;
+
+  for( index = 0; index < Timer_RP2040_SchedCount; index++ )
+  {
+    Timer_RP2040_SchedHeap[index]->heapSlot = TIMER_RP2040_SCHED_INACTIVE;
+  }
+  Timer_RP2040_SchedCount = 0;
+  (void)now;
+
+  return Timer_RP2040_SchedProgram();
+}
+
+/**
+ * Inserts a timer, whose deadline is already set, into the heap. Reprograms the alarm if its window closes first.
+ * @param timer: Idle timer to insert.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the heap is full or the alarm could not be programmed
+ *
+ * @pre Timer is not pending.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedInsert ( tTimer_RP2040_SoftTimer * timer )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( Timer_RP2040_SchedCount >= TIMER_RP2040_SCHED_MAX_TIMERS )
+  {
+    retVal = E_NOT_OK;
+  }
+  else
+  {
+    Timer_RP2040_SchedPlace(Timer_RP2040_SchedCount, timer);
+    Timer_RP2040_SchedCount++;
+    Timer_RP2040_SchedSiftUp(Timer_RP2040_SchedCount - 1);
+
+    /* Only a new earliest window end needs the hardware alarm to move. */
+    if( (timer->deadline + timer->slack) < Timer_RP2040_SchedWake )
+    {
+      Timer_RP2040_SchedWake = timer->deadline + timer->slack;
+      retVal = Timer_RP2040_SchedArm(Timer_RP2040_SchedWake);
+    }
+  }
+
+  return retVal;
+}
+
+/**
+ * Removes a pending timer from the heap. Reprograms the alarm if the wake was the end of its window.
+ * @param timer: Pending timer to remove.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *
+ * @pre Timer is pending.
+ * @post Timer is not pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedCancel ( tTimer_RP2040_SoftTimer * timer )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  Timer_RP2040_SchedRemove(timer);
+
+  /* Cancelling the timer the alarm waits for moves the hardware alarm to the next window end. */
+  if( (timer->deadline + timer->slack) <= Timer_RP2040_SchedWake )
+  {
+    retVal = Timer_RP2040_SchedProgram();
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports if a timer is in the heap.
+ * @param timer: Timer to check.
+ *
+ * @return
+ *         0: if the timer is not pending.
+ *         1: if the timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_SchedPending ( const tTimer_RP2040_SoftTimer * timer )
+{
+  return (TIMER_RP2040_SCHED_INACTIVE != timer->heapSlot) ? 1 : 0;
+}
+
+/**
+ * Reports when the scheduler next has work to do: the end of the earliest closing window.
+ *
+ * @return
+ *         Absolute time in microseconds, or TIMER_RP2040_SCHED_NO_DEADLINE if no timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedNextEvent ( void )
+{
+  return Timer_RP2040_SchedWake;
+}
+
+/**
+ * Expires every timer at the top of the heap whose window has opened, then programs the alarm for the next window end.
+ * Since the wake is the end of the earliest closing window, every timer expired by it is still within its window.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *
+ * @pre Called within the scheduler critical section.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedExpire ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_SoftTimer * timer;
+  uint64 now;
+  uint8 pending;
+
+  do
+  {
+    now = Timer_RP2040_RawNow64();
+    if( (Timer_RP2040_SchedCount > 0) && (Timer_RP2040_SchedHeap[0]->deadline <= now) )
+    {
+      Timer_RP2040_SchedStats.wakes++;
+    }
+
+    /* Expire everything that is due. Callbacks run outside of the critical section, and may start or stop timers. */
+    while( (Timer_RP2040_SchedCount > 0) && (Timer_RP2040_SchedHeap[0]->deadline <= now) )
+    {
+      timer = Timer_RP2040_SchedHeap[0];
+      Timer_RP2040_SchedRemove(timer);
+      Timer_RP2040_SchedTally(timer, now);
+      TIMER_RP2040_SCHED_EXIT_CRITICAL();
+      timer->callback(timer->context);
+      TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    }
+    retVal = Timer_RP2040_SchedProgram();
+
+    /* If the next wake passed while programming the alarm, the comparator missed it - go around again. */
+    pending = 0;
+    if( Timer_RP2040_SchedWake <= Timer_RP2040_RawNow64() )
+    {
+      pending = 1;
+    }
+  } while( (E_OK == retVal) && (1 == pending) );
+
+  return retVal;
+}
+
+#else /* TIMER_RP2040_SCHED_BACKEND_WHEEL */
+
+/**
+ * Pushes a timer at the front of a wheel slot list.
+ * @param head: Wheel slot (list head) to push on.
+ * @param timer: Timer to link.
+ *
+ * @pre Timer is not linked.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedLink ( tTimer_RP2040_SoftTimer ** head, tTimer_RP2040_SoftTimer * timer )
+{
+  timer->next = *head;
+  if( NULL != timer->next )
+  {
+    timer->next->link = &timer->next;
+  }
+  *head = timer;
+  timer->link = head;
+}
+
+/**
+ * Unlinks a timer from whichever list it is on, in constant time.
+ * @param timer: Linked timer.
+ *
+ * @pre Timer is linked.
+ * @post Timer is not linked.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedUnlink ( tTimer_RP2040_SoftTimer * timer )
+{
+  *timer->link = timer->next;
+  if( NULL != timer->next )
+  {
+    timer->next->link = timer->link;
+  }
+  timer->next = NULL;
+  timer->link = NULL;
+}
+
+/**
+ * Moves a whole wheel slot onto a local list head, so that the slot can be refilled while the list is worked on.
+ * @param head: Local list head to receive the timers.
+ * @param slot: Wheel slot to empty.
+ *
+ * @pre n/a
+ * @post Slot is empty.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedDetach ( tTimer_RP2040_SoftTimer ** head, tTimer_RP2040_SoftTimer ** slot )
+{
+  *head = *slot;
+  *slot = NULL;
+  if( NULL != *head )
+  {
+    (*head)->link = head;
+  }
+}
+
+/**
+ * Hashes a timer into the wheel level and slot matching its distance from the current wheel tick. Timers due before
+ * the current wheel tick are placed at the current wheel tick.
+ * @param timer: Unlinked timer with 'expiryTick' set.
+ *
+ * @pre Timer is not linked.
+ * @post Timer is linked into the wheel.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedPlace ( tTimer_RP2040_SoftTimer * timer )
+{
+  uint64 expires = timer->expiryTick;
+  uint64 delta;
+  uint32 level = 0;
+
+  if( expires < Timer_RP2040_SchedWheelTick )
+  {
+    expires = Timer_RP2040_SchedWheelTick;
+  }
+  delta = expires - Timer_RP2040_SchedWheelTick;
+
+  /* Beyond the range of the wheel - park in the furthest slot, it is re-hashed once cascaded. */
+  if( delta >= TIMER_RP2040_SCHED_WHEEL_RANGE )
+  {
+    delta = TIMER_RP2040_SCHED_WHEEL_RANGE - 1;
+    expires = Timer_RP2040_SchedWheelTick + delta;
+  }
+
+  while( delta >= ((uint64)1 << (TIMER_RP2040_SCHED_WHEEL_BITS * (level + 1))) )
+  {
+    level++;
+  }
+
+  Timer_RP2040_SchedLink(&Timer_RP2040_SchedWheel[level][(uint32)(expires >> (TIMER_RP2040_SCHED_WHEEL_BITS * level)) &
+                                                         TIMER_RP2040_SCHED_WHEEL_MASK], timer);
+}
+
+/**
+ * Re-hashes the slot of 'level' which the wheel tick has just reached into the levels below.
+ * @param level: Wheel level to cascade, 1 or above.
+ *
+ * @return
+ *         Index of the slot that was cascaded - zero means the next level up is due as well.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_SchedCascade ( uint32 level )
+{
+  tTimer_RP2040_SoftTimer * list;
+  tTimer_RP2040_SoftTimer * timer;
+  uint32 index = (uint32)(Timer_RP2040_SchedWheelTick >> (TIMER_RP2040_SCHED_WHEEL_BITS * level)) &
+                 TIMER_RP2040_SCHED_WHEEL_MASK;
+
+  Timer_RP2040_SchedDetach(&list, &Timer_RP2040_SchedWheel[level][index]);
+  while( NULL != list )
+  {
+    timer = list;
+    Timer_RP2040_SchedUnlink(timer);
+    Timer_RP2040_SchedPlace(timer);
+  }
+
+  return index;
+}
+
+/**
+ * Finds the first tick, at or after the current wheel tick, at which the wheel has work to do: a non-empty level 0
+ * slot to expire, or a non-empty upper level slot to cascade. A slot of level n is only ever looked at on ticks that
+ * are a multiple of 2^(TIMER_RP2040_SCHED_WHEEL_BITS * n), so each level is scanned once around in those steps.
+ *
+ * @return
+ *         Next tick with work, or TIMER_RP2040_SCHED_NO_DEADLINE if the wheel is empty.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedNextTick ( void )
+{
+  uint64 next = TIMER_RP2040_SCHED_NO_DEADLINE;
+  uint64 span;
+  uint64 tick;
+  uint32 level;
+  uint32 shift;
+  uint32 slot;
+
+  for( level = 0; (level < TIMER_RP2040_SCHED_WHEEL_LEVELS) && (ZERO32 != Timer_RP2040_SchedCount); level++ )
+  {
+    shift = TIMER_RP2040_SCHED_WHEEL_BITS * level;
+    span = (uint64)1 << shift;
+    tick = (Timer_RP2040_SchedWheelTick + (span - 1)) & ~(span - 1);
+
+    /* Stop at the first hit, or once this level can no longer beat the levels below. */
+    for( slot = 0; (slot < TIMER_RP2040_SCHED_WHEEL_SLOTS) && (tick < next); slot++ )
+    {
+      if( NULL != Timer_RP2040_SchedWheel[level][(uint32)(tick >> shift) & TIMER_RP2040_SCHED_WHEEL_MASK] )
+      {
+        next = tick;
+      }
+      tick += span;
+    }
+  }
+
+  return next;
+}
+
+#if ( TIMER_RP2040_TICKLESS != 0 )
+/**
+ * Programs the scheduler alarm for the start of 'tick'.
+ * @param tick: Wheel tick to wake up at.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedWakeAt ( uint64 tick )
+{
+  Timer_RP2040_SchedWheelWake = tick;
+
+  return Timer_RP2040_SchedArm(tick * TIMER_RP2040_SCHED_TICK_US);
+}
+#endif
+
+/**
+ * Programs the scheduler alarm for the next wheel tick - or, with TIMER_RP2040_TICKLESS, for the next tick with work
+ * only, disarming it while the wheel is empty.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedProgram ( void )
+{
+#if ( TIMER_RP2040_TICKLESS != 0 )
+  Std_ErrorCode retVal = E_OK;
+  uint64 next = Timer_RP2040_SchedNextTick();
+
+  if( TIMER_RP2040_SCHED_NO_DEADLINE == next )
+  {
+    Timer_RP2040_SchedWheelWake = TIMER_RP2040_SCHED_NO_DEADLINE;
+    retVal = Timer_RP2040_DisarmAlarmN(TIMER_RP2040_SCHED_ALARM_INDEX);
+  }
+  else
+  {
+    retVal = Timer_RP2040_SchedWakeAt(next);
+  }
+
+  return retVal;
+#else
+  return Timer_RP2040_SchedArm(Timer_RP2040_SchedWheelTick * TIMER_RP2040_SCHED_TICK_US);
+#endif
+}
+
+/**
+ * Drops every pending timer, aligns the wheel to the current time and starts the tick.
+ * @param now: Current time in microseconds.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *
+ * @pre n/a
+ * @post No soft timer is pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedReset ( uint64 now )
+{
+  uint32 level;
+  uint32 slot;
+
+  for( level = 0; level < TIMER_RP2040_SCHED_WHEEL_LEVELS; level++ )
+  {
+    for( slot = 0; slot < TIMER_RP2040_SCHED_WHEEL_SLOTS; slot++ )
+    {
+      while( NULL != Timer_RP2040_SchedWheel[level][slot] )
+      {
+        Timer_RP2040_SchedUnlink(Timer_RP2040_SchedWheel[level][slot]);
+      }
+    }
+  }
+  Timer_RP2040_SchedCount = 0;
+  Timer_RP2040_SchedWheelTick = (now / TIMER_RP2040_SCHED_TICK_US) + 1;
+
+  return Timer_RP2040_SchedProgram();
+}
+
+/**
+ * Picks the expiry tick of a timer within its window: the tick with the most trailing zero bits between the first
+ * tick at or after the deadline and the last tick at or before the end of the window. Timers with overlapping windows
+ * so tend to meet on the same tick, and with TIMER_RP2040_TICKLESS on ticks which are far apart.
+ * @param timer: Timer with 'deadline' and 'slack' set.
+ *
+ * @return
+ *         Expiry tick.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedExpiryTick ( const tTimer_RP2040_SoftTimer * timer )
+{
+  uint64 first = (timer->deadline + (TIMER_RP2040_SCHED_TICK_US - 1)) / TIMER_RP2040_SCHED_TICK_US;
+  uint64 last = (timer->deadline + timer->slack) / TIMER_RP2040_SCHED_TICK_US;
+  uint64 differ;
+  uint64 bit = 1;
+
+  if( last > first )
+  {
+    /*
+      Above the highest bit in which the two differ both are equal, and 'last' has that bit set while 'first' has
+      not - clearing every bit of 'last' below it stays within the window.
+    */
+    differ = first ^ last;
+    while( 0 != (differ >> 1) )
+    {
+      differ >>= 1;
+      bit <<= 1;
+    }
+    first = last & ~(bit - 1);
+  }
+
+  return first;
+}
+
+/**
+ * Hashes a timer, whose deadline is already set, into the wheel. Only touches the hardware with TIMER_RP2040_TICKLESS,
+ * when the timer is due before the programmed wake.
+ * @param timer: Idle timer to insert.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *
+ * @pre Timer is not pending.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedInsert ( tTimer_RP2040_SoftTimer * timer )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  timer->expiryTick = Timer_RP2040_SchedExpiryTick(timer);
+  Timer_RP2040_SchedPlace(timer);
+  Timer_RP2040_SchedCount++;
+
+#if ( TIMER_RP2040_TICKLESS != 0 )
+  /*
+    Wake no later than the expiry tick. Waking there rather than at the cascade tick of the timer's slot is enough,
+    since the wheel catches up every tick it skipped on wake-up.
+  */
+  if( timer->expiryTick < Timer_RP2040_SchedWheelWake )
+  {
+    retVal = Timer_RP2040_SchedWakeAt((timer->expiryTick > Timer_RP2040_SchedWheelTick) ? timer->expiryTick :
+                                                                                          Timer_RP2040_SchedWheelTick);
+  }
+#endif
+
+  return retVal;
+}
+
+/**
+ * Unlinks a pending timer from the wheel. Never touches the hardware - with TIMER_RP2040_TICKLESS the programmed wake
+ * may turn out to be spurious, and is moved on when it fires.
+ * @param timer: Pending timer to remove.
+ *
+ * @return
+ *         0: 'E_OK' always
+ *
+ * @pre Timer is pending.
+ * @post Timer is not pending.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedCancel ( tTimer_RP2040_SoftTimer * timer )
+{
+  Timer_RP2040_SchedUnlink(timer);
+  Timer_RP2040_SchedCount--;
+
+  return E_OK;
+}
+
+/**
+ * Reports if a timer is linked into the wheel (or into the list of timers currently expiring).
+ * @param timer: Timer to check.
+ *
+ * @return
+ *         0: if the timer is not pending.
+ *         1: if the timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_SchedPending ( const tTimer_RP2040_SoftTimer * timer )
+{
+  return (NULL != timer->link) ? 1 : 0;
+}
+
+/**
+ * Reports when the scheduler next has work to do: the start of the next tick that expires or cascades a timer. For
+ * timers on the upper levels this is their cascade tick, which may be earlier than their deadline.
+ *
+ * @return
+ *         Absolute time in microseconds, or TIMER_RP2040_SCHED_NO_DEADLINE if no timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SchedNextEvent ( void )
+{
+  uint64 next = Timer_RP2040_SchedNextTick();
+
+  return (TIMER_RP2040_SCHED_NO_DEADLINE != next) ? (next * TIMER_RP2040_SCHED_TICK_US) : TIMER_RP2040_SCHED_NO_DEADLINE;
+}
+
+/**
+ * Advances the wheel up to the current time one tick at a time, cascading the upper levels at their boundaries and
+ * expiring the level 0 slot of every tick. Then programs the alarm for the next tick. With TIMER_RP2040_TICKLESS the
+ * ticks without work are skipped, so a long sleep is caught up in a few steps.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *
+ * @pre Called within the scheduler critical section.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_SchedExpire ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+  tTimer_RP2040_SoftTimer * expired;
+  tTimer_RP2040_SoftTimer * timer;
+  uint64 nowTick;
+  uint64 now;
+#if ( TIMER_RP2040_TICKLESS != 0 )
+  uint64 next;
+#endif
+  uint32 index;
+  uint32 level;
+
+  do
+  {
+    now = Timer_RP2040_RawNow64();
+    nowTick = now / TIMER_RP2040_SCHED_TICK_US;
+
+    while( Timer_RP2040_SchedWheelTick <= nowTick )
+    {
+#if ( TIMER_RP2040_TICKLESS != 0 )
+      /* Catch up in one step over the ticks without work - nothing in them would expire or cascade. */
+      next = Timer_RP2040_SchedNextTick();
+      if( next > nowTick )
+      {
+        Timer_RP2040_SchedWheelTick = nowTick + 1;
+        continue;
+      }
+      Timer_RP2040_SchedWheelTick = next;
+#endif
+      index = (uint32)Timer_RP2040_SchedWheelTick & TIMER_RP2040_SCHED_WHEEL_MASK;
+
+      /* At a level 0 wrap, pull the next slot of each upper level down - as long as that level wrapped as well. */
+      if( ZERO32 == index )
+      {
+        level = 1;
+        while( (level < TIMER_RP2040_SCHED_WHEEL_LEVELS) && (ZERO32 == Timer_RP2040_SchedCascade(level)) )
+        {
+          level++;
+        }
+      }
+
+      /*
+        Take the due slot off the wheel and step the tick before running callbacks, so timers restarted from a
+        callback land in a later slot. Callbacks may still stop timers on the local list.
+      */
+      Timer_RP2040_SchedDetach(&expired, &Timer_RP2040_SchedWheel[0][index]);
+      Timer_RP2040_SchedWheelTick++;
+      if( NULL != expired )
+      {
+        Timer_RP2040_SchedStats.wakes++;
+      }
+
+      while( NULL != expired )
+      {
+        timer = expired;
+        Timer_RP2040_SchedUnlink(timer);
+        Timer_RP2040_SchedCount--;
+        Timer_RP2040_SchedTally(timer, now);
+        TIMER_RP2040_SCHED_EXIT_CRITICAL();
+        timer->callback(timer->context);
+        TIMER_RP2040_SCHED_ENTER_CRITICAL();
+      }
+    }
+
+    retVal = Timer_RP2040_SchedProgram();
+
+    /* If the next tick passed while programming the alarm, the comparator missed it - go around again. */
+  } while( (E_OK == retVal) &&
+           (Timer_RP2040_SchedWheelTick <= (Timer_RP2040_RawNow64() / TIMER_RP2040_SCHED_TICK_US)) );
+
+  return retVal;
+}
+
+#endif /* TIMER_RP2040_SCHED_BACKEND */
+
+/**
+ * Alarm callback registered with the timer IRQ dispatcher for TIMER_RP2040_SCHED_ALARM_INDEX.
+ * @param alarmIndex: Alarm which fired, unused.
+ * @param context: Unused.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Scheduler was previously initialized.
+ * @post See Timer_RP2040_SchedProcess.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SchedIrq ( uint8 alarmIndex, void * context )
+{
+  (void)alarmIndex;
+  (void)context;
+
+  (void)Timer_RP2040_SchedProcess();
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the soft timer scheduler. Drops every pending soft timer and disarms the scheduler alarm (HEAP) or
+ * starts the tick (WHEEL).
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the operation is not successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post No soft timer is pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedInit ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    Timer_RP2040_SchedTicks = Timer_RP2040_RawNow64() / TIMER_RP2040_SCHED_TICK_US;
+    Timer_RP2040_SchedStats.expired = ZERO32;
+    Timer_RP2040_SchedStats.wakes = ZERO32;
+    Timer_RP2040_SchedStats.lateTotal = 0;
+    retVal = Timer_RP2040_SchedReset(Timer_RP2040_RawNow64());
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+  }
+
+  if( E_OK == retVal )
+  {
+    Timer_RP2040_SchedStatus = TIMER_RP2040_INIT;
+    retVal = Timer_RP2040_RegisterCallback(TIMER_RP2040_SCHED_ALARM_INDEX, Timer_RP2040_SchedIrq, NULL);
+  }
+
+  return retVal;
+}
+
+/**
+ * Starts (or restarts) a soft timer at an absolute deadline.
+ * @param timer: Caller owned soft timer storage.
+ * @param deadline: Absolute expiry time in microseconds.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedStart ( tTimer_RP2040_SoftTimer * timer, uint64 deadline,
+                                        tTimer_RP2040_SoftTimerCallback callback, void * context )
+{
+  return Timer_RP2040_SchedStartWindow(timer, deadline, ZERO32, callback, context);
+}
+
+/**
+ * Starts (or restarts) a soft timer which may expire anywhere in the window [deadline, deadline + slack].
+ * @param timer: Caller owned soft timer storage.
+ * @param deadline: Earliest expiry time in microseconds.
+ * @param slack: Microseconds the expiry may be delayed by.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedStartWindow ( tTimer_RP2040_SoftTimer * timer, uint64 deadline, uint32 slack,
+                                              tTimer_RP2040_SoftTimerCallback callback, void * context )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( (NULL == timer) || (NULL == callback) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_SchedStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+
+    /* A restart is a cancel followed by an insert. */
+    if( 1 == Timer_RP2040_SchedPending(timer) )
+    {
+      retVal = Timer_RP2040_SchedCancel(timer);
+    }
+
+    if( E_OK == retVal )
+    {
+      timer->deadline = deadline;
+      timer->slack = slack;
+      timer->callback = callback;
+      timer->context = context;
+      retVal = Timer_RP2040_SchedInsert(timer);
+    }
+
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+  }
+
+  return retVal;
+}
+
+/**
+ * Starts (or restarts) a soft timer relative to the current time.
+ * @param timer: Caller owned soft timer storage.
+ * @param delay: Microseconds from now until expiry.
+ * @param callback: Function called on expiry, may not be NULL.
+ * @param context: Passed to the callback untouched.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if there is no room left for another pending timer
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedStartIn ( tTimer_RP2040_SoftTimer * timer, uint32 delay,
+                                          tTimer_RP2040_SoftTimerCallback callback, void * context )
+{
+  return Timer_RP2040_SchedStart(timer, Timer_RP2040_RawNow64() + delay, callback, context);
+}
+
+/**
+ * Cancels a pending soft timer. Cancelling a timer which is not pending is not an error.
+ * @param timer: Soft timer to cancel.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post Timer is not pending.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedStop ( tTimer_RP2040_SoftTimer * timer )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( NULL == timer )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_SchedStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    if( 1 == Timer_RP2040_SchedPending(timer) )
+    {
+      retVal = Timer_RP2040_SchedCancel(timer);
+    }
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports if the soft timer is pending.
+ * @param timer: Soft timer to check.
+ *
+ * @return
+ *         0: if the timer is not pending (or NULL).
+ *         1: if the timer is pending.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint8 Timer_RP2040_SchedIsActive ( const tTimer_RP2040_SoftTimer * timer )
+{
+  uint8 retVal = 0;
+
+  if( NULL != timer )
+  {
+    retVal = Timer_RP2040_SchedPending(timer);
+  }
+
+  return retVal;
+}
+
+/**
+ * Expires every soft timer that is due, and programs the next wake into the scheduler alarm.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the alarm could not be programmed
+ *         3: 'E_MODULE_UNINIT' if the scheduler is not yet initialized
+ *
+ * @pre Scheduler was previously initialized.
+ * @post The scheduler alarm is armed for the next wake, or disarmed if nothing is pending (HEAP).
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedProcess ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_SchedStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    retVal = Timer_RP2040_InterruptClearN(TIMER_RP2040_SCHED_ALARM_INDEX);
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    retVal = Timer_RP2040_SchedExpire();
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports the coalescing statistics gathered since Timer_RP2040_SchedInit.
+ * @param stats: Receives the statistics.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the input parameter is not valid
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SchedCoalesceStats ( tTimer_RP2040_SchedStats * stats )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( NULL == stats )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    *stats = Timer_RP2040_SchedStats;
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+    stats->saved = stats->expired - stats->wakes;
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports the time until the scheduler next has work to do, for tickless idle.
+ *
+ * @return
+ *         Microseconds until the next event, 0 if it is already due, or TIMER_RP2040_SCHED_NO_DEADLINE if no timer is
+ *         pending (or the scheduler is not initialized).
+ *
+ * @pre Scheduler was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_SchedTimeToNext ( void )
+{
+  uint64 next = TIMER_RP2040_SCHED_NO_DEADLINE;
+  uint64 now;
+
+  if( TIMER_RP2040_INIT == Timer_RP2040_SchedStatus )
+  {
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    next = Timer_RP2040_SchedNextEvent();
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+
+    if( TIMER_RP2040_SCHED_NO_DEADLINE != next )
+    {
+      now = Timer_RP2040_RawNow64();
+      next = (next > now) ? (next - now) : 0;
+    }
+  }
+
+  return next;
+}
+
+/**
+ * Catches the logical tick count up with the 64 bit timer. The count is derived from the counter rather than from
+ * tick interrupts, so ticks slept through in tickless idle are not lost.
+ *
+ * @return
+ *         Number of TIMER_RP2040_SCHED_TICK_US ticks since the previous call (or since Timer_RP2040_SchedInit).
+ *
+ * @pre Scheduler was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_SchedCatchUpTicks ( void )
+{
+  uint64 ticks;
+  uint32 elapsed = ZERO32;
+
+  if( TIMER_RP2040_INIT == Timer_RP2040_SchedStatus )
+  {
+    ticks = Timer_RP2040_RawNow64() / TIMER_RP2040_SCHED_TICK_US;
+
+    TIMER_RP2040_SCHED_ENTER_CRITICAL();
+    if( ticks > Timer_RP2040_SchedTicks )
+    {
+      elapsed = (uint32)(ticks - Timer_RP2040_SchedTicks);
+      Timer_RP2040_SchedTicks = ticks;
+    }
+    TIMER_RP2040_SCHED_EXIT_CRITICAL();
+  }
+
+  return elapsed;
+}
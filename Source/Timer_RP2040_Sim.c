@@ -0,0 +1,351 @@
+/**
+ *
+* @file "Timer_RP2040_Sim.c"
+* @author Madrick3
+* @brief Deterministic discrete-event simulator for the VIRTUAL_TARGET register model. The simulated time is kept
+* here as a 64 bit value and mirrored into Timer_Live at every step. Events are the comparator matches of the armed
+* alarms; the time between two events is skipped in a single step.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.02.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-012   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-012   |  Level sensitive interrupt delivery
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* One 32 bit comparator epoch */
+#define TIMER_RP2040_SIM_EPOCH (((uint64)1) << 32)
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Sim.h"
+
+#if defined( VIRTUAL_TARGET )
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SimTime = 0;
+
+TIMER_RP2040_LOCAL tTimer_RP2040_SimIrq Timer_RP2040_SimIrqHandler = NULL;
+
+/* Deliveries given up at TIMER_RP2040_SIM_MAX_IRQ_NESTING since the last reset */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_SimStormCount = 0;
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Mirrors the simulated time into the counter registers. TIMEHR/TIMELR are latched to the same value, as a
+ * TIMELR-then-TIMEHR read would see on the hardware.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SimPublish ( void )
+{
+  TIMER_REG_WRITE(TIMER_REG_TIMERAWH, (uint32)(Timer_RP2040_SimTime >> 32));
+  TIMER_REG_WRITE(TIMER_REG_TIMERAWL, (uint32)Timer_RP2040_SimTime);
+  TIMER_REG_WRITE(TIMER_REG_TIMEHR, (uint32)(Timer_RP2040_SimTime >> 32));
+  TIMER_REG_WRITE(TIMER_REG_TIMELR, (uint32)Timer_RP2040_SimTime);
+}
+
+/**
+ * Recomputes the masked interrupt status.
+ *
+ * @return
+ *         The new INTS value.
+ *
+ * @pre n/a
+ * @post INTS = (INTR | INTF) & INTE.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_SimUpdateInts ( void )
+{
+  uint32 ints = (TIMER_REG_READ(TIMER_REG_INTR) | TIMER_REG_READ(TIMER_REG_INTF)) & TIMER_REG_READ(TIMER_REG_INTE);
+
+  TIMER_REG_WRITE(TIMER_REG_INTS, ints);
+
+  return ints;
+}
+
+/**
+ * Runs the interrupt handler while interrupts are pending. TIMER_IRQ is level sensitive, so the handler is called
+ * again for as long as INTS stays non-zero - on the hardware a handler which leaves it set is re-entered forever.
+ * The simulator gives up after TIMER_RP2040_SIM_MAX_IRQ_NESTING calls and counts the storm instead.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_SimDeliver ( void )
+{
+  uint32 ints = Timer_RP2040_SimUpdateInts();
+  uint32 nesting = 0;
+
+  while( (NULL != Timer_RP2040_SimIrqHandler) && (ZERO32 != ints) )
+  {
+    if( nesting >= TIMER_RP2040_SIM_MAX_IRQ_NESTING )
+    {
+      Timer_RP2040_SimStormCount++;
+      break;
+    }
+
+    Timer_RP2040_SimIrqHandler();
+    ints = Timer_RP2040_SimUpdateInts();
+    nesting++;
+  }
+}
+
+/**
+ * Time until an armed alarm matches. The comparator looks at the low 32 bits of the time only, and a value equal to
+ * the current time has already been passed.
+ * @param alarmIndex: Index of an armed alarm.
+ *
+ * @return
+ *         Microseconds until the match, within range [1:2^32].
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint64 Timer_RP2040_SimAlarmDistance ( uint8 alarmIndex )
+{
+  uint32 distance = TIMER_REG_READ(TIMER_REG_ALARMn(alarmIndex)) - (uint32)Timer_RP2040_SimTime;
+
+  return (ZERO32 == distance) ? TIMER_RP2040_SIM_EPOCH : (uint64)distance;
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Resets the register model to its power-on state at 'time'.
+ * @param time: Simulated time in microseconds.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post Every register other than the counters is 0, no handler is installed.
+ * @invariant n/a
+ *
+ */
+void Timer_RP2040_SimReset ( uint64 time )
+{
+  tRP2040_Timer powerOn = { 0 };
+
+  Timer_Live = powerOn;
+  Timer_RP2040_SimIrqHandler = NULL;
+  Timer_RP2040_SimStormCount = ZERO32;
+  Timer_RP2040_SimTime = time;
+  Timer_RP2040_SimPublish();
+}
+
+/**
+ * Installs the simulated TIMER_IRQ handler.
+ * @param handler: Interrupt handler, or NULL.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+void Timer_RP2040_SimSetIrq ( tTimer_RP2040_SimIrq handler )
+{
+  Timer_RP2040_SimIrqHandler = handler;
+}
+
+/**
+ * Reports how often the handler left an interrupt pending after TIMER_RP2040_SIM_MAX_IRQ_NESTING calls.
+ *
+ * @return
+ *         Interrupt storms since Timer_RP2040_SimReset.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_SimIrqStorms ( void )
+{
+  return Timer_RP2040_SimStormCount;
+}
+
+/**
+ * Reports the simulated time.
+ *
+ * @return
+ *         Simulated time in microseconds.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_SimNow ( void )
+{
+  return Timer_RP2040_SimTime;
+}
+
+/**
+ * Reports when the next comparator match happens.
+ *
+ * @return
+ *         Simulated time of the next match, or TIMER_RP2040_SIM_NO_EVENT.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint64 Timer_RP2040_SimNextEvent ( void )
+{
+  uint64 next = TIMER_RP2040_SIM_NO_EVENT;
+  uint64 distance;
+  uint32 armed = TIMER_REG_READ(TIMER_REG_ARMED) & TIMER_RP2040_ALLALARMS_BITMASK;
+  uint8 alarmIndex;
+
+  if( ZERO32 == (TIMER_REG_READ(TIMER_REG_PAUSE) & TIMER_PAUSE_MASK) )
+  {
+    for( alarmIndex = 0; alarmIndex <= ALARM_MAX_INDEX; alarmIndex++ )
+    {
+      if( ZERO32 != (armed & INT_TO_BITMAP(alarmIndex)) )
+      {
+        distance = Timer_RP2040_SimAlarmDistance(alarmIndex);
+        if( (Timer_RP2040_SimTime + distance) < next )
+        {
+          next = Timer_RP2040_SimTime + distance;
+        }
+      }
+    }
+  }
+
+  return next;
+}
+
+/**
+ * Advances the simulated time to 'time', servicing every comparator match on the way.
+ * @param time: Simulated time to advance to.
+ *
+ * @return
+ *         Number of comparator matches.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_SimAdvanceTo ( uint64 time )
+{
+  uint32 matches = ZERO32;
+  uint32 fired;
+  uint64 next;
+  uint8 alarmIndex;
+
+  /* Interrupts forced or left pending before the call are taken first */
+  Timer_RP2040_SimDeliver();
+
+  next = Timer_RP2040_SimNextEvent();
+  while( next <= time )
+  {
+    Timer_RP2040_SimTime = next;
+    Timer_RP2040_SimPublish();
+
+    fired = ZERO32;
+    for( alarmIndex = 0; alarmIndex <= ALARM_MAX_INDEX; alarmIndex++ )
+    {
+      if( (ZERO32 != (TIMER_REG_READ(TIMER_REG_ARMED) & INT_TO_BITMAP(alarmIndex))) &&
+          (TIMER_REG_READ(TIMER_REG_ALARMn(alarmIndex)) == (uint32)next) )
+      {
+        fired |= INT_TO_BITMAP(alarmIndex);
+        matches++;
+      }
+    }
+
+    /* ARMED clears and INTR latches when the comparator matches */
+    TIMER_REG_W1C(TIMER_REG_ARMED, fired);
+    TIMER_REG_SET(TIMER_REG_INTR, fired);
+    Timer_RP2040_SimDeliver();
+
+    next = Timer_RP2040_SimNextEvent();
+  }
+
+  if( (time > Timer_RP2040_SimTime) && (ZERO32 == (TIMER_REG_READ(TIMER_REG_PAUSE) & TIMER_PAUSE_MASK)) )
+  {
+    Timer_RP2040_SimTime = time;
+    Timer_RP2040_SimPublish();
+  }
+
+  return matches;
+}
+
+/**
+ * Advances the simulated time by 'delta' microseconds.
+ * @param delta: Microseconds to advance.
+ *
+ * @return
+ *         Number of comparator matches.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_SimAdvance ( uint64 delta )
+{
+  return Timer_RP2040_SimAdvanceTo(Timer_RP2040_SimTime + delta);
+}
+
+/**
+ * Jumps to the next comparator match and services it.
+ *
+ * @return
+ *         0: 'E_OK' if an alarm matched
+ *         1: 'E_NOT_OK' if no alarm is armed
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_SimStep ( void )
+{
+  Std_ErrorCode retVal = E_NOT_OK;
+  uint64 next = Timer_RP2040_SimNextEvent();
+
+  if( TIMER_RP2040_SIM_NO_EVENT != next )
+  {
+    (void)Timer_RP2040_SimAdvanceTo(next);
+    retVal = E_OK;
+  }
+
+  return retVal;
+}
+
+#endif /* VIRTUAL_TARGET */
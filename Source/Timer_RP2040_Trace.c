@@ -0,0 +1,494 @@
+/**
+ *
+* @file "Timer_RP2040_Trace.c"
+* @author Madrick3
+* @brief Binary event trace ring. Head and tail are free running byte counters, the position in the ring is the
+* counter masked with TIMER_RP2040_TRACE_MASK, and the fill level is tail - head. Dropping the oldest record walks
+* over its encoding and moves the base time on by its delta, so the remaining deltas stay anchored.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.02.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-016   |  Initial Creation
+  01.02.00 |  Madrick3 |  user-016   |  Ring size must hold the longest record
+************************************************************/
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Varint continuation bit and payload */
+#define TIMER_RP2040_TRACE_VARINT_MORE 0x80u
+#define TIMER_RP2040_TRACE_VARINT_BITS 0x7Fu
+
+/* Longest varint of a 32 bit value */
+#define TIMER_RP2040_TRACE_VARINT_MAX 5
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include "Timer_RP2040_Trace.h"
+
+/************************************************************
+  ENUMS AND TYPEDEFS
+************************************************************/
+
+/* Compile time check that the ring size is a power of two and holds the longest record - the drop loop of
+   Timer_RP2040_TraceRecord would not end otherwise */
+typedef uint8 tTimer_RP2040_TraceBytesCheck[(((TIMER_RP2040_TRACE_BYTES & TIMER_RP2040_TRACE_MASK) == 0) &&
+                                             (TIMER_RP2040_TRACE_BYTES >= TIMER_RP2040_TRACE_RECORD_MAX)) ? 1 : -1];
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+TIMER_RP2040_LOCAL tTimer_RP2040_Status Timer_RP2040_TraceStatus = TIMER_RP2040_UNINIT;
+
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_TraceRing[TIMER_RP2040_TRACE_BYTES];
+
+/* First byte of the oldest record */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceHead = ZERO32;
+
+/* Next free byte */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceTail = ZERO32;
+
+/* Time the delta of the oldest record is relative to */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceBase = ZERO32;
+
+/* Time of the newest record */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceLast = ZERO32;
+
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceDropCount = ZERO32;
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+/**
+ * Encodes 'value' as a varint.
+ * @param out: Receives up to TIMER_RP2040_TRACE_VARINT_MAX bytes.
+ * @param value: Value to encode.
+ *
+ * @return
+ *         Number of bytes written.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint8 Timer_RP2040_TraceVarintPut ( uint8 * out, uint32 value )
+{
+  uint8 length = 0;
+
+  while( value > TIMER_RP2040_TRACE_VARINT_BITS )
+  {
+    out[length] = (uint8)((value & TIMER_RP2040_TRACE_VARINT_BITS) | TIMER_RP2040_TRACE_VARINT_MORE);
+    value >>= 7;
+    length++;
+  }
+  out[length] = (uint8)value;
+
+  return (uint8)(length + 1u);
+}
+
+/**
+ * Decodes a varint from the ring.
+ * @param position: Free running byte counter of the first byte, advanced past the varint.
+ *
+ * @return
+ *         Decoded value.
+ *
+ * @pre The ring holds a complete record at 'position'.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceVarintRing ( uint32 * position )
+{
+  uint32 value = ZERO32;
+  uint8 shift = 0;
+  uint8 byte;
+
+  do
+  {
+    byte = Timer_RP2040_TraceRing[*position & TIMER_RP2040_TRACE_MASK];
+    value |= (uint32)(byte & TIMER_RP2040_TRACE_VARINT_BITS) << shift;
+    shift += 7u;
+    *position += 1uL;
+  } while( 0u != (byte & TIMER_RP2040_TRACE_VARINT_MORE) );
+
+  return value;
+}
+
+/**
+ * Drops the oldest record of the ring.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre Called inside the trace critical section, the ring is not empty.
+ * @post The base time is the time of the dropped record.
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_TraceDropOldest ( void )
+{
+  uint32 position = Timer_RP2040_TraceHead;
+
+  Timer_RP2040_TraceBase += Timer_RP2040_TraceVarintRing(&position);
+  /* Event id */
+  position += 1uL;
+  (void)Timer_RP2040_TraceVarintRing(&position);
+
+  Timer_RP2040_TraceHead = position;
+  Timer_RP2040_TraceDropCount++;
+}
+
+/**
+ * Writes 'value' as 4 little endian bytes.
+ * @param out: Receives the bytes.
+ * @param value: Value to write.
+ *
+ * @return
+ *         n/a
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL void Timer_RP2040_TracePut32 ( uint8 * out, uint32 value )
+{
+  out[0] = (uint8)value;
+  out[1] = (uint8)(value >> 8);
+  out[2] = (uint8)(value >> 16);
+  out[3] = (uint8)(value >> 24);
+}
+
+/**
+ * Reads 4 little endian bytes.
+ * @param in: Bytes to read.
+ *
+ * @return
+ *         The value.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL uint32 Timer_RP2040_TraceGet32 ( const uint8 * in )
+{
+  return (uint32)in[0] | ((uint32)in[1] << 8) | ((uint32)in[2] << 16) | ((uint32)in[3] << 24);
+}
+
+/**
+ * Decodes a varint from an image, checking the bounds.
+ * @param reader: Decoding state, its offset is advanced past the varint.
+ * @param value: Receives the decoded value.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if the varint is truncated or longer than 32 bits
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+TIMER_RP2040_LOCAL Std_ErrorCode Timer_RP2040_TraceVarintImage ( tTimer_RP2040_TraceReader * reader, uint32 * value )
+{
+  Std_ErrorCode retVal = E_INVALID_PARAM;
+  uint8 count = 0;
+  uint8 byte;
+
+  *value = ZERO32;
+  while( (reader->offset < reader->length) && (count < TIMER_RP2040_TRACE_VARINT_MAX) )
+  {
+    byte = reader->data[reader->offset];
+    *value |= (uint32)(byte & TIMER_RP2040_TRACE_VARINT_BITS) << (7u * count);
+    reader->offset++;
+    count++;
+
+    if( 0u == (byte & TIMER_RP2040_TRACE_VARINT_MORE) )
+    {
+      retVal = E_OK;
+      break;
+    }
+  }
+
+  return retVal;
+}
+
+/************************************************************
+  GLOBAL FUNCTIONS
+************************************************************/
+
+/**
+ * Initializes the trace, dropping any recorded events.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the timer is not yet initialized
+ *
+ * @pre Timer module was previously enabled.
+ * @post The trace is empty, the base time is the current time.
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_TraceInit ( void )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 state;
+
+  /* Check that the timer module was previously init */
+  if( TIMER_RP2040_INIT != Timer_RP2040_IsInit() )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_TRACE_ENTER_CRITICAL(state);
+    Timer_RP2040_TraceHead = ZERO32;
+    Timer_RP2040_TraceTail = ZERO32;
+    Timer_RP2040_TraceBase = Timer_RP2040_RawNow32();
+    Timer_RP2040_TraceLast = Timer_RP2040_TraceBase;
+    Timer_RP2040_TraceDropCount = ZERO32;
+    Timer_RP2040_TraceStatus = TIMER_RP2040_INIT;
+    TIMER_RP2040_TRACE_EXIT_CRITICAL(state);
+  }
+
+  return retVal;
+}
+
+/**
+ * Appends an event. The time is read inside the critical section, so the records are in time order and every delta
+ * is non-negative.
+ * @param eventId: Application defined event id.
+ * @param argument: Application defined argument.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         3: 'E_MODULE_UNINIT' if the trace is not yet initialized
+ *
+ * @pre Trace was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_TraceRecord ( uint8 eventId, uint32 argument )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint8 record[TIMER_RP2040_TRACE_RECORD_MAX];
+  uint8 length;
+  uint8 byte;
+  uint32 now;
+  uint32 state;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_TraceStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+
+  if( E_OK == retVal )
+  {
+    TIMER_RP2040_TRACE_ENTER_CRITICAL(state);
+    now = Timer_RP2040_RawNow32();
+
+    length = Timer_RP2040_TraceVarintPut(record, now - Timer_RP2040_TraceLast);
+    record[length] = eventId;
+    length++;
+    length += Timer_RP2040_TraceVarintPut(&record[length], argument);
+
+    while( ((uint32)(Timer_RP2040_TraceTail - Timer_RP2040_TraceHead) + length) > TIMER_RP2040_TRACE_BYTES )
+    {
+      Timer_RP2040_TraceDropOldest();
+    }
+
+    for( byte = 0; byte < length; byte++ )
+    {
+      Timer_RP2040_TraceRing[(Timer_RP2040_TraceTail + byte) & TIMER_RP2040_TRACE_MASK] = record[byte];
+    }
+    Timer_RP2040_TraceTail += length;
+    Timer_RP2040_TraceLast = now;
+    TIMER_RP2040_TRACE_EXIT_CRITICAL(state);
+  }
+
+  return retVal;
+}
+
+/**
+ * Copies the trace into an image. Interrupts stay masked for the copy, which is bounded by TIMER_RP2040_TRACE_BYTES.
+ * @param image: Receives the image.
+ * @param size: Size of 'image' in bytes.
+ * @param length: Receives the length of the image.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         1: 'E_NOT_OK' if the image does not fit into 'size' bytes
+ *         2: 'E_PARAM' if an input parameter is not valid
+ *         3: 'E_MODULE_UNINIT' if the trace is not yet initialized
+ *
+ * @pre Trace was previously initialized.
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_TraceExport ( uint8 * image, uint32 size, uint32 * length )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 used;
+  uint32 byte;
+  uint32 state;
+
+  if( TIMER_RP2040_INIT != Timer_RP2040_TraceStatus )
+  {
+    retVal = E_MODULE_UNINIT;
+  }
+  else if( (NULL == image) || (NULL == length) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else
+  {
+    TIMER_RP2040_TRACE_ENTER_CRITICAL(state);
+    used = Timer_RP2040_TraceTail - Timer_RP2040_TraceHead;
+
+    if( (TIMER_RP2040_TRACE_HEADER_BYTES + used) > size )
+    {
+      retVal = E_NOT_OK;
+    }
+    else
+    {
+      Timer_RP2040_TracePut32(&image[0], Timer_RP2040_TraceBase);
+      Timer_RP2040_TracePut32(&image[4], Timer_RP2040_TraceDropCount);
+      Timer_RP2040_TracePut32(&image[8], used);
+      for( byte = 0; byte < used; byte++ )
+      {
+        image[TIMER_RP2040_TRACE_HEADER_BYTES + byte] =
+          Timer_RP2040_TraceRing[(Timer_RP2040_TraceHead + byte) & TIMER_RP2040_TRACE_MASK];
+      }
+      *length = TIMER_RP2040_TRACE_HEADER_BYTES + used;
+    }
+    TIMER_RP2040_TRACE_EXIT_CRITICAL(state);
+  }
+
+  return retVal;
+}
+
+/**
+ * Reports the number of records dropped because the ring was full.
+ *
+ * @return
+ *         Dropped records since Timer_RP2040_TraceInit.
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+uint32 Timer_RP2040_TraceDropped ( void )
+{
+  return Timer_RP2040_TraceDropCount;
+}
+
+/**
+ * Prepares 'reader' to decode an exported image.
+ * @param reader: Decoding state.
+ * @param image: Exported image.
+ * @param length: Length of the image in bytes.
+ *
+ * @return
+ *         0: 'E_OK' if successful
+ *         2: 'E_PARAM' if an input parameter is not valid or the header does not match 'length'
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_TraceReaderInit ( tTimer_RP2040_TraceReader * reader, const uint8 * image, uint32 length )
+{
+  Std_ErrorCode retVal = E_OK;
+
+  if( (NULL == reader) || (NULL == image) || (length < TIMER_RP2040_TRACE_HEADER_BYTES) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else if( Timer_RP2040_TraceGet32(&image[8]) != (length - TIMER_RP2040_TRACE_HEADER_BYTES) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else
+  {
+    reader->data = &image[TIMER_RP2040_TRACE_HEADER_BYTES];
+    reader->length = length - TIMER_RP2040_TRACE_HEADER_BYTES;
+    reader->offset = ZERO32;
+    reader->time = Timer_RP2040_TraceGet32(&image[0]);
+    reader->dropped = Timer_RP2040_TraceGet32(&image[4]);
+  }
+
+  return retVal;
+}
+
+/**
+ * Decodes the next record of an image. A truncated record leaves the reader at its end.
+ * @param reader: Decoding state.
+ * @param event: Receives the record.
+ *
+ * @return
+ *         0: 'E_OK' if a record was decoded
+ *         1: 'E_NOT_OK' if all records have been read
+ *         2: 'E_PARAM' if an input parameter is not valid or the record is truncated
+ *
+ * @pre n/a
+ * @post n/a
+ * @invariant n/a
+ *
+ */
+Std_ErrorCode Timer_RP2040_TraceNext ( tTimer_RP2040_TraceReader * reader, tTimer_RP2040_TraceEvent * event )
+{
+  Std_ErrorCode retVal = E_OK;
+  uint32 delta = ZERO32;
+
+  if( (NULL == reader) || (NULL == event) )
+  {
+    retVal = E_INVALID_PARAM;
+  }
+  else if( reader->offset >= reader->length )
+  {
+    retVal = E_NOT_OK;
+  }
+  else
+  {
+    retVal = Timer_RP2040_TraceVarintImage(reader, &delta);
+
+    if( (E_OK == retVal) && (reader->offset < reader->length) )
+    {
+      event->id = reader->data[reader->offset];
+      reader->offset++;
+      retVal = Timer_RP2040_TraceVarintImage(reader, &event->argument);
+    }
+    else
+    {
+      retVal = E_INVALID_PARAM;
+    }
+
+    if( E_OK == retVal )
+    {
+      reader->time += delta;
+      event->time = reader->time;
+    }
+    else
+    {
+      reader->offset = reader->length;
+    }
+  }
+
+  return retVal;
+}
@@ -0,0 +1,337 @@
+/**
+ *
+* @file "Timer_RP2040_Bench.c"
+* @author Madrick3
+* @brief Host benchmark for the Timer_RP2040 component (VIRTUAL_TARGET build only). Time on the virtual target is
+* driven by writing the register model directly, so the numbers measure only the software cost of the driver.
+* Built with TIMER_RP2040_REG_PROBE, every register access made by the driver is counted as well.
+*
+* Output is one comma separated row per measurement:
+*   suite,backend,live_timers,operation,ns_per_op,reg_per_op
+* The 'api' suite times each public driver API in isolation, the 'sched' suite the scheduler at several populations.
+* Before timing, the unit conversions are checked against C division for every 32 bit input.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.10.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-002   |  Initial Creation - scheduler backends
+  01.02.00 |  Madrick3 |  user-013   |  Driver API suite and register access counts
+  01.03.00 |  Madrick3 |  user-015   |  Unit conversions, exhaustive check
+  01.04.00 |  Madrick3 |  user-016   |  Event trace
+  01.05.00 |  Madrick3 |  user-017   |  Profiling markers
+  01.06.00 |  Madrick3 |  user-020   |  Shadow register variant
+  01.07.00 |  Madrick3 |  user-021   |  Batch alarm status
+  01.08.00 |  Madrick3 |  user-022   |  Bitmask arm and disarm
+  01.09.00 |  Madrick3 |  user-023   |  Relative arm
+  01.10.00 |  Madrick3 |  user-025   |  Polling timeouts
+************************************************************/
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "Timer_RP2040_Sched.h"
+#include "Timer_RP2040_Defer.h"
+#include "Timer_RP2040_Conv.h"
+#include "Timer_RP2040_Trace.h"
+#include "Timer_RP2040_Prof.h"
+#include "Timer_RP2040_Timeout.h"
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Build variant - scheduler backend, and if the shadow registers are used */
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP ) && ( TIMER_RP2040_SHADOW == 0 )
+#define BENCH_BACKEND_NAME "heap"
+#elif ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+#define BENCH_BACKEND_NAME "heap_shadow"
+#elif ( TIMER_RP2040_SHADOW == 0 )
+#define BENCH_BACKEND_NAME "wheel"
+#else
+#define BENCH_BACKEND_NAME "wheel_shadow"
+#endif
+
+/* Largest population benchmarked - the heap backend must be built with at least this many timers */
+#define BENCH_MAX_TIMERS 100000uL
+
+/* Deadlines are spread over this window */
+#define BENCH_SPREAD_US 10000000uL
+
+/* Number of cancel + restart pairs timed per population */
+#define BENCH_RESTARTS 200000uL
+
+/* Calls timed per driver API */
+#define BENCH_API_CALLS 1000000uL
+
+#if ( TIMER_RP2040_REG_PROBE != 0 )
+#define BENCH_REG_ACCESSES() Timer_RP2040_RegAccessCount
+#else
+#define BENCH_REG_ACCESSES() ZERO32
+#endif
+
+/*
+  Times BENCH_API_CALLS executions of 'statement' and reports them as 'operation'. The statement stores results in
+  benchSink so that the optimizer cannot drop the call.
+*/
+#define BENCH_API(operation, statement) \
+  do \
+  { \
+    uint32 call_; \
+    uint32 accesses_ = BENCH_REG_ACCESSES(); \
+    clock_t start_ = clock(); \
+    for( call_ = 0; call_ < BENCH_API_CALLS; call_++ ) \
+    { \
+      statement; \
+    } \
+    benchReport("api", 0, (operation), benchSeconds(start_, clock()), BENCH_API_CALLS, \
+                BENCH_REG_ACCESSES() - accesses_); \
+  } while( 0 )
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+extern volatile tRP2040_Timer Timer_Live;
+
+static tTimer_RP2040_SoftTimer benchTimers[BENCH_MAX_TIMERS];
+
+static uint32 benchSeed = 1;
+
+static uint32 benchExpired = 0;
+
+static volatile uint32 benchSink = 0;
+
+/************************************************************
+  LOCAL FUNCTIONS
+************************************************************/
+
+static uint32 benchRandom ( void )
+{
+  benchSeed = (benchSeed * 1103515245uL) + 12345uL;
+  return benchSeed >> 8;
+}
+
+static void benchSetTime ( uint64 time )
+{
+  Timer_Live.TIMEHR = (uint32)(time >> 32);
+  Timer_Live.TIMELR = (uint32)time;
+  Timer_Live.TIMERAWH = (uint32)(time >> 32);
+  Timer_Live.TIMERAWL = (uint32)time;
+}
+
+static double benchSeconds ( clock_t start, clock_t end )
+{
+  return ((double)(end - start)) / (double)CLOCKS_PER_SEC;
+}
+
+static void benchCallback ( void * context )
+{
+  (void)context;
+  benchExpired++;
+}
+
+static void benchAlarmCallback ( uint8 alarmIndex, void * context )
+{
+  (void)context;
+  benchSink += alarmIndex;
+}
+
+static void benchDeferFunction ( void * context, uint32 timestamp )
+{
+  (void)context;
+  benchSink += timestamp;
+}
+
+static void benchReport ( const char * suite, uint32 liveTimers, const char * operation, double seconds, uint32 ops,
+                          uint32 accesses )
+{
+  printf("%s,%s,%lu,%s,%.1f,%.2f\n", suite, BENCH_BACKEND_NAME, (unsigned long)liveTimers, operation,
+         (ops > 0) ? ((seconds * 1e9) / (double)ops) : 0.0,
+         (ops > 0) ? ((double)accesses / (double)ops) : 0.0);
+}
+
+/**
+ * Benchmarks every public driver API once in isolation. Each call is made on a valid argument, so the numbers are
+ * those of the success path.
+ */
+static void benchApi ( void )
+{
+  uint32 high;
+  uint32 low;
+  uint32 zero = ZERO32;
+  tTimer_RP2040_DeferEntry entry;
+  tTimer_RP2040_AlarmSnapshot snapshot;
+  uint32 triggers[4] = { 5000, 5000, 5000, 5000 };
+  tTimer_RP2040_Timeout timeout;
+  tTimer_RP2040_Timeout64 timeout64;
+
+  benchSetTime(0x123456789uLL);
+
+  BENCH_API("IsInit", benchSink += (uint32)Timer_RP2040_IsInit());
+  BENCH_API("TimerRead", benchSink += Timer_RP2040_TimerRead(&high, &low));
+  BENCH_API("TimerRead32", benchSink += Timer_RP2040_TimerRead32(&low));
+  BENCH_API("TimerRead64", benchSink += (uint32)Timer_RP2040_TimerRead64());
+  BENCH_API("Now32", benchSink += Timer_RP2040_Now32());
+  BENCH_API("Now64", benchSink += (uint32)Timer_RP2040_Now64());
+  BENCH_API("Elapsed32", benchSink += Timer_RP2040_Elapsed32(low));
+  Timer_RP2040_TimeoutStart(&timeout, 5000);
+  Timer_RP2040_TimeoutStart64(&timeout64, 5000);
+  BENCH_API("TimeoutExpired", benchSink += Timer_RP2040_TimeoutExpired(&timeout));
+  BENCH_API("TimeoutExpired64", benchSink += Timer_RP2040_TimeoutExpired64(&timeout64));
+  BENCH_API("TimerWrite", benchSink += Timer_RP2040_TimerWrite(&zero, &zero));
+  benchSetTime(0x123456789uLL);
+
+  BENCH_API("ArmAlarmN", benchSink += Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 5000));
+  BENCH_API("CheckAlarmN", benchSink += (uint32)Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+  BENCH_API("CheckAlarms", benchSink += Timer_RP2040_CheckAlarms(&snapshot, 0));
+  BENCH_API("DisarmAlarmN", benchSink += Timer_RP2040_DisarmAlarmN(ALARM1_INDEX));
+  BENCH_API("ArmAlarmRelative", benchSink += Timer_RP2040_ArmAlarmRelative(ALARM1_INDEX, 5000, NULL));
+  BENCH_API("ArmAlarms", benchSink += Timer_RP2040_ArmAlarms(0x7, triggers));
+  BENCH_API("DisarmAlarms", benchSink += Timer_RP2040_DisarmAlarms(0x7));
+  BENCH_API("ArmAlarmAt64", benchSink += Timer_RP2040_ArmAlarmAt64(ALARM1_INDEX, 0x123460000uLL));
+  BENCH_API("ArmAlarmAt64_parked", benchSink += Timer_RP2040_ArmAlarmAt64(ALARM1_INDEX, 0x923460000uLL));
+  (void)Timer_RP2040_DisarmAlarmN(ALARM1_INDEX);
+
+  BENCH_API("InterruptEnable", benchSink += Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM2_INDEX)));
+  BENCH_API("InterruptDisable", benchSink += Timer_RP2040_InterruptDisable(INT_TO_BITMAP(ALARM2_INDEX)));
+  BENCH_API("InterruptEnabled", benchSink += Timer_RP2040_InterruptEnabled());
+  BENCH_API("InterruptNTrigger", benchSink += Timer_RP2040_InterruptNTrigger(ALARM2_INDEX));
+  BENCH_API("InterruptNStatusCheck", benchSink += (uint32)Timer_RP2040_InterruptNStatusCheck(ALARM2_INDEX));
+  BENCH_API("InterruptClearN", benchSink += Timer_RP2040_InterruptClearN(ALARM2_INDEX));
+  Timer_Live.INTF = ZERO32;
+
+  BENCH_API("RegisterCallback", benchSink += Timer_RP2040_RegisterCallback(ALARM2_INDEX, benchAlarmCallback, NULL));
+  BENCH_API("IrqHandler_idle", Timer_RP2040_IrqHandler());
+  BENCH_API("IrqHandler_one", Timer_Live.INTS = INT_TO_BITMAP(ALARM2_INDEX); Timer_RP2040_IrqHandler());
+  BENCH_API("PeriodicStart", benchSink += Timer_RP2040_PeriodicStart(ALARM2_INDEX, 1000, benchAlarmCallback, NULL));
+  BENCH_API("IrqHandler_periodic", Timer_Live.INTS = INT_TO_BITMAP(ALARM2_INDEX); Timer_RP2040_IrqHandler());
+  BENCH_API("PeriodicStop", benchSink += Timer_RP2040_PeriodicStop(ALARM2_INDEX));
+  Timer_Live.INTS = ZERO32;
+
+  (void)Timer_RP2040_DeferInit();
+  BENCH_API("DeferPost+Pop", benchSink += Timer_RP2040_DeferPost(benchDeferFunction, NULL);
+                             benchSink += Timer_RP2040_DeferPop(&entry));
+  BENCH_API("DeferPost+Process", benchSink += Timer_RP2040_DeferPost(benchDeferFunction, NULL);
+                                 benchSink += Timer_RP2040_DeferProcess(1));
+
+  (void)Timer_RP2040_TraceInit();
+  BENCH_API("TraceRecord", benchSink += Timer_RP2040_TraceRecord((uint8)call_, call_));
+
+  (void)Timer_RP2040_ProfInit();
+  BENCH_API("ProfBegin+End", Timer_RP2040_ProfBegin(0); Timer_RP2040_ProfEnd(0));
+
+  BENCH_API("UsToMs", benchSink += Timer_RP2040_UsToMs(benchRandom()));
+  BENCH_API("UsToS", benchSink += Timer_RP2040_UsToS(benchRandom()));
+  BENCH_API("SToMin", benchSink += Timer_RP2040_SToMin(benchRandom()));
+  BENCH_API("Us64ToMs", benchSink += (uint32)Timer_RP2040_Us64ToMs(((uint64)benchRandom() << 32) | benchRandom()));
+  BENCH_API("Us64ToS", benchSink += (uint32)Timer_RP2040_Us64ToS(((uint64)benchRandom() << 32) | benchRandom()));
+}
+
+/**
+ * Checks the 32 bit unit conversions against C division for all 2^32 inputs.
+ *
+ * @return
+ *         Number of mismatches.
+ */
+static uint32 benchConvVerify ( void )
+{
+  uint32 mismatches = 0;
+  uint32 value = 0;
+
+  do
+  {
+    mismatches += (Timer_RP2040_UsToMs(value) != (value / 1000uL)) ? 1 : 0;
+    mismatches += (Timer_RP2040_UsToS(value) != (value / 1000000uL)) ? 1 : 0;
+    mismatches += (Timer_RP2040_SToMin(value) != (value / 60uL)) ? 1 : 0;
+    value++;
+  } while( ZERO32 != value );
+
+  if( mismatches > 0 )
+  {
+    printf("conv,%s,0,ERROR mismatches %lu\n", BENCH_BACKEND_NAME, (unsigned long)mismatches);
+  }
+
+  return mismatches;
+}
+
+/**
+ * Benchmarks the scheduler with 'count' live timers: start, cancel + restart, and expiry (driven by 1ms steps of the
+ * virtual clock).
+ */
+static void benchSched ( uint32 count )
+{
+  clock_t start;
+  uint32 accesses;
+  uint32 i;
+  uint32 restarts;
+  uint64 time;
+
+  benchSeed = count;
+  benchExpired = 0;
+  benchSetTime(0);
+  (void)Timer_RP2040_SchedInit();
+
+  accesses = BENCH_REG_ACCESSES();
+  start = clock();
+  for( i = 0; i < count; i++ )
+  {
+    (void)Timer_RP2040_SchedStart(&benchTimers[i], 1000 + (benchRandom() % BENCH_SPREAD_US), benchCallback, NULL);
+  }
+  benchReport("sched", count, "start", benchSeconds(start, clock()), count, BENCH_REG_ACCESSES() - accesses);
+
+  restarts = (count < BENCH_RESTARTS) ? BENCH_RESTARTS : count;
+  accesses = BENCH_REG_ACCESSES();
+  start = clock();
+  for( i = 0; i < restarts; i++ )
+  {
+    tTimer_RP2040_SoftTimer * timer = &benchTimers[benchRandom() % count];
+    (void)Timer_RP2040_SchedStop(timer);
+    (void)Timer_RP2040_SchedStart(timer, 1000 + (benchRandom() % BENCH_SPREAD_US), benchCallback, NULL);
+  }
+  benchReport("sched", count, "stop+start", benchSeconds(start, clock()), restarts,
+              BENCH_REG_ACCESSES() - accesses);
+
+  accesses = BENCH_REG_ACCESSES();
+  start = clock();
+  for( time = 1000; time <= (BENCH_SPREAD_US + 2000); time += 1000 )
+  {
+    benchSetTime(time);
+    (void)Timer_RP2040_SchedProcess();
+  }
+  benchReport("sched", count, "expire", benchSeconds(start, clock()), benchExpired, BENCH_REG_ACCESSES() - accesses);
+
+  if( benchExpired != count )
+  {
+    printf("sched,%s,%lu,ERROR expired %lu\n", BENCH_BACKEND_NAME, (unsigned long)count, (unsigned long)benchExpired);
+  }
+}
+
+/************************************************************
+  MAIN
+************************************************************/
+int main ( void )
+{
+  if( E_OK != Timer_RP2040_Init() )
+  {
+    printf("Timer_RP2040_Init failed\n");
+    return 1;
+  }
+
+  if( ZERO32 != benchConvVerify() )
+  {
+    return 1;
+  }
+
+  printf("suite,backend,live_timers,operation,ns_per_op,reg_per_op\n");
+  benchApi();
+  benchSched(10);
+  benchSched(1000);
+  benchSched(BENCH_MAX_TIMERS);
+
+  return 0;
+}
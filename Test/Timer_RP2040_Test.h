@@ -1,4 +1,12 @@
 #include "Timer_RP2040.h"
+#include "Timer_RP2040_Sched.h"
+#include "Timer_RP2040_Defer.h"
+#include "Timer_RP2040_Sim.h"
+#include "Timer_RP2040_Conv.h"
+#include "Timer_RP2040_Trace.h"
+#include "Timer_RP2040_Prof.h"
+#include "Timer_RP2040_Delay.h"
+#include "Timer_RP2040_Timeout.h"
 
 /************************************************************
   LOCAL VARIABLES
@@ -9,6 +17,14 @@ extern tRP2040_Timer Timer_Uninit;
 
 extern volatile tRP2040_Timer Timer_Live;
 
+extern volatile uint32 Timer_RP2040_CallbackBitmap;
+
+extern volatile uint32 Timer_RP2040_ParkedBitmap;
+
+extern volatile uint32 Timer_RP2040_ForcedBitmap;
+
+extern void * Timer_RP2040_CallbackContext[];
+
 /************************************************************
   LOCAL FUNCTIONS
 ************************************************************/
@@ -22,3 +38,21 @@ extern Std_ErrorCode Timer_RP2040_ReadTimerHigh ( uint32 * TimerHigh );
 
 extern Std_ErrorCode Timer_RP2040_WriteTimerLow ( uint32 TimerLow );
 extern Std_ErrorCode Timer_RP2040_WriteTimerHigh ( uint32 TimerHigh );
+
+extern void Timer_RP2040_PeriodicIrq ( uint8 alarmIndex, void * context );
+
+/* Scheduler */
+extern tTimer_RP2040_Status Timer_RP2040_SchedStatus;
+extern uint32 Timer_RP2040_SchedCount;
+
+/* Deferred work queue */
+extern tTimer_RP2040_Status Timer_RP2040_DeferStatus;
+
+/* Event trace */
+extern tTimer_RP2040_Status Timer_RP2040_TraceStatus;
+
+/* Delays */
+extern tTimer_RP2040_Status Timer_RP2040_DelayStatus;
+
+/* Simulator */
+extern uint32 Timer_RP2040_SimStormCount;
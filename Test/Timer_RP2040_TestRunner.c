@@ -23,6 +23,9 @@
 #include <setjmp.h>
 #include <stdio.h>
 #include "Timer_RP2040.h"
+#include "Timer_RP2040_Sched.h"
+#include "Timer_RP2040_Defer.h"
+#include "Timer_RP2040_Prof.h"
 
 /*=======External Functions This Runner Calls=====*/
 extern void setUp(void);
@@ -66,12 +69,14 @@ extern void test_Alarm_CheckAlarm_nSet(void);
 extern void test_Alarm_CheckAlarm_0Triggered(void);
 extern void test_Alarm_CheckAlarm_nTriggered(void);
 extern void test_Alarm_CheckAlarm_InvalidIndex(void);
+extern void test_Alarm_CheckAlarm_ArmedAtZero(void);
+extern void test_Alarm_CheckAlarm_RearmReleasesForced(void);
 
 /* Alarm Writes */
-extern void test_Alarm_SetAlarm0_With0_Fails(void);
+extern void test_Alarm_SetAlarm0_With0_Arms(void);
 extern void test_Alarm_SetAlarm0_WithN(void);
 extern void test_Alarm_SetAlarm0_WithOnes(void);
-extern void test_Alarm_SetAlarmN_With0_Fails(void);
+extern void test_Alarm_SetAlarmN_With0_Arms(void);
 extern void test_Alarm_SetAlarmN_WithN(void);
 extern void test_Alarm_SetAlarmN_WithOnes(void);
 extern void test_Alarm_SetAlarmN_InvalidIndex_Fails(void);
@@ -87,6 +92,15 @@ extern void test_Alarm_DisarmAlarm_0WasSetIsNotSet_nNotTouched(void);
 /* TIMERAW reads */
 extern void test_TIMERAW_ReadTIMERAWL_ReturnsOK(void);
 extern void test_TIMERAW_ReadTIMERAWL_ReturnsOKWithN(void);
+extern void test_TIMERAW_Read64_CombinesRAWHandRAWL(void);
+extern void test_TIMERAW_Read64_DoesNotUseLatchedRegisters(void);
+extern void test_TIMERAW_Now32_ReadsTIMERAWL(void);
+extern void test_TIMERAW_Now64_CombinesRAWHandRAWL(void);
+extern void test_TIMERAW_Elapsed32_AcrossWrap(void);
+#if ( TIMER_RP2040_DEBUG != 0 )
+extern void test_TIMERAW_Now32_Debug_ReturnsZeroWhenUninit(void);
+extern void test_TIMERAW_Debug_ArmDecisionsUseRawTime(void);
+#endif
 
 /* INTR */ /* INTR is Raw Interrupts - this must be written to to service an interrupt */
 extern void test_Interrupt_InterruptClear_ReturnsOK(void);
@@ -113,6 +127,133 @@ extern void test_Interrupt_InterruptCheck_ReturnsFailed(void);
 extern void test_Interrupt_InterruptCheck_IsSet(void);
 extern void test_Interrupt_InterruptCheck_IsNotSet(void);
 
+/* IRQ dispatch */
+extern void test_Irq_RegisterCallback_ReturnsInvalidParam(void);
+extern void test_Irq_Handler_DispatchesPendingInIndexOrder(void);
+extern void test_Irq_Handler_AcknowledgesUnregistered(void);
+extern void test_Irq_Handler_TakesTriggeredInterruptOnce(void);
+extern void test_Irq_Handler_SkipsCallbackRemovedDuringDispatch(void);
+
+/* Periodic alarms */
+extern void test_Periodic_Start_ReturnsInvalidParam(void);
+extern void test_Periodic_RearmsFromDeadlineNotFromNow(void);
+extern void test_Periodic_OverrunSkipsMissedPeriods(void);
+extern void test_Periodic_DeadlineDueNowIsNotSkipped(void);
+extern void test_Periodic_DeadlineWrapsThroughZero(void);
+extern void test_Periodic_Stop_DisarmsAndRemovesCallback(void);
+extern void test_Periodic_Stop_WithdrawsPendingPeriod(void);
+
+/* 64 bit deadlines */
+extern void test_Alarm64_ArmAlarmAt64_ReturnsInvalidParam(void);
+extern void test_Alarm64_ArmAlarmAt64_ArmsInsideWindow(void);
+extern void test_Alarm64_ArmAlarmAt64_ParksFarDeadline(void);
+extern void test_Alarm64_DisarmAlarm_ClearsParkedDeadline(void);
+extern void test_Alarm64_Polled_ExpiryStaysVisible(void);
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/* Latency statistics */
+extern void test_Latency_Snapshot_ReturnsInvalidParam(void);
+extern void test_Latency_Handler_RecordsLog2Buckets(void);
+extern void test_Latency_Handler_WrapsThroughZero(void);
+extern void test_Latency_Handler_SkipsTriggeredInterrupt(void);
+#endif
+
+/* Unit conversion */
+extern void test_Conv_Divide32_MatchesReference(void);
+extern void test_Conv_Multiply_DoesNotOverflow(void);
+extern void test_Conv_Us64_MatchesReference(void);
+extern void test_Conv_UDiv32_MatchesReference(void);
+extern void test_Conv_UDiv64_MatchesReference(void);
+
+/* Simulator */
+extern void test_Sim_AlarmMatch_ClearsArmedSetsIntr(void);
+extern void test_Sim_Ints_MaskedByInte(void);
+extern void test_Sim_Irq_LevelSensitiveReportsStorm(void);
+extern void test_Sim_AlarmAtCurrentTime_MatchesNextEpoch(void);
+extern void test_Sim_Pause_FreezesTime(void);
+extern void test_Sim_Soak_OneHourOfAlarmsAndSoftTimers(void);
+
+/* Deferred work queue */
+extern void test_Defer_Init_ReturnsUninit_TimerNotInit(void);
+extern void test_Defer_Post_ReturnsInvalidParam(void);
+extern void test_Defer_Process_RunsInOrderWithTimestamp(void);
+extern void test_Defer_Post_FailsWhenFull(void);
+extern void test_Defer_Stress_TwoThreads(void);
+
+/* Event trace */
+extern void test_Trace_Init_ReturnsUninit_TimerNotInit(void);
+extern void test_Trace_Record_DecodesWithDeltaTimestamps(void);
+extern void test_Trace_Record_DropsOldestWhenFull(void);
+extern void test_Trace_Reader_RejectsTruncatedImage(void);
+extern void test_Trace_Sim_RecordsFromAlarmInterrupt(void);
+
+/* Profiling */
+extern void test_Prof_Init_ReturnsUninit_TimerNotInit(void);
+#if ( TIMER_RP2040_PROF != 0 )
+extern void test_Prof_BeginEnd_AccumulatesAcrossWrap(void);
+extern void test_Prof_Dump_WritesTable(void);
+#endif
+
+/* Safe arming */
+extern void test_SafeArm_PassedDeadline_ForcesInterrupt(void);
+extern void test_SafeArm_Try_ReportsExpired(void);
+extern void test_SafeArm_ForcedFromBothContexts(void);
+
+/* Shadow registers */
+extern void test_Shadow_InterruptEnabled_TracksEnableDisable(void);
+#if ( TIMER_RP2040_SHADOW != 0 )
+extern void test_Shadow_CheckAlarm_FollowsArmed(void);
+#endif
+
+/* Batch alarm status */
+extern void test_CheckAlarms_SnapshotsAllAlarms(void);
+extern void test_CheckAlarms_AcknowledgesForcedAlarm(void);
+
+/* Bitmask arm and disarm */
+extern void test_ArmAlarms_ReturnsInvalidParam(void);
+extern void test_ArmAlarms_ArmsInLockstep(void);
+extern void test_DisarmAlarms_DisarmsBitmask(void);
+
+/* Relative arm */
+extern void test_ArmAlarmRelative_ReturnsInvalidParam(void);
+extern void test_ArmAlarmRelative_ArmsFromCurrentTime(void);
+
+/* Delays */
+extern void test_Delay_ReturnsUninit_TimerNotInit(void);
+extern void test_Delay_Us_ReturnsInvalidParam(void);
+extern void test_Delay_ShortDelaySpins(void);
+extern void test_Delay_LongDelaySleepsOnAlarm(void);
+
+/* Timeouts */
+extern void test_Timeout_ExpiresAcrossWrap(void);
+extern void test_Timeout64_LongBudget(void);
+
+#if ( TIMER_RP2040_MULTICORE != 0 )
+/* Multicore */
+extern void test_Lock_Stress_TwoCores(void);
+#endif
+
+/* Scheduler */
+extern void test_Sched_Init_ReturnsUninit_TimerNotInit(void);
+extern void test_Sched_Start_ReturnsInvalidParam(void);
+extern void test_Sched_Irq_HandlerProcessesSchedulerAlarm(void);
+extern void test_Sched_TimeToNext_ReportsNextEvent(void);
+extern void test_Sched_CatchUpTicks_CountsSkippedTicks(void);
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+extern void test_Sched_Start_ProgramsEarliestDeadline(void);
+extern void test_Sched_Stop_EarliestReprogramsNext(void);
+extern void test_Sched_Start_FailsWhenFull(void);
+extern void test_Sched_Process_ExpiresDueTimersInOrder(void);
+extern void test_Sched_Process_FarDeadlineUsesIntermediateWake(void);
+extern void test_Sched_Window_CoalescesOverlappingTimers(void);
+#else
+extern void test_Sched_Wheel_Init_ArmsNextTick(void);
+extern void test_Sched_Wheel_ExpiresOnFirstTickAfterDeadline(void);
+extern void test_Sched_Wheel_StopAndRestart(void);
+extern void test_Sched_Wheel_Window_MeetsOnAlignedTick(void);
+extern void test_Sched_Wheel_Tickless_WakesOnlyForWork(void);
+#endif
+
 /*=======Test Reset Option=====*/
 void resetTest(void);
 void resetTest(void)
@@ -166,12 +307,14 @@ int main(void)
   RUN_TEST(test_Alarm_CheckAlarm_0Triggered, 80);
   RUN_TEST(test_Alarm_CheckAlarm_nTriggered, 81);
   RUN_TEST(test_Alarm_CheckAlarm_InvalidIndex, 82);
+  RUN_TEST(test_Alarm_CheckAlarm_ArmedAtZero, 82);
+  RUN_TEST(test_Alarm_CheckAlarm_RearmReleasesForced, 82);
 
   /* Alarm Writes */
-  RUN_TEST(test_Alarm_SetAlarm0_With0_Fails, 20);
+  RUN_TEST(test_Alarm_SetAlarm0_With0_Arms, 20);
   RUN_TEST(test_Alarm_SetAlarm0_WithN, 20);
   RUN_TEST(test_Alarm_SetAlarm0_WithOnes, 20);
-  RUN_TEST(test_Alarm_SetAlarmN_With0_Fails, 20);
+  RUN_TEST(test_Alarm_SetAlarmN_With0_Arms, 20);
   RUN_TEST(test_Alarm_SetAlarmN_WithN, 20);
   RUN_TEST(test_Alarm_SetAlarmN_WithOnes, 20);
   RUN_TEST(test_Alarm_SetAlarmN_InvalidIndex_Fails, 20);
@@ -187,6 +330,15 @@ int main(void)
   /* TIMERAW reads */
   RUN_TEST(test_TIMERAW_ReadTIMERAWL_ReturnsOK, 21);
   RUN_TEST(test_TIMERAW_ReadTIMERAWL_ReturnsOKWithN, 21);
+  RUN_TEST(test_TIMERAW_Read64_CombinesRAWHandRAWL, 21);
+  RUN_TEST(test_TIMERAW_Read64_DoesNotUseLatchedRegisters, 21);
+  RUN_TEST(test_TIMERAW_Now32_ReadsTIMERAWL, 21);
+  RUN_TEST(test_TIMERAW_Now64_CombinesRAWHandRAWL, 21);
+  RUN_TEST(test_TIMERAW_Elapsed32_AcrossWrap, 21);
+#if ( TIMER_RP2040_DEBUG != 0 )
+  RUN_TEST(test_TIMERAW_Now32_Debug_ReturnsZeroWhenUninit, 21);
+  RUN_TEST(test_TIMERAW_Debug_ArmDecisionsUseRawTime, 21);
+#endif
 
   /* INTR */ /* INTR is Raw Interrupts - this must be written to to service an interrupt */
   RUN_TEST(test_Interrupt_InterruptClear_ReturnsOK, 22);
@@ -213,5 +365,136 @@ int main(void)
   RUN_TEST(test_Interrupt_InterruptCheck_IsSet, 27);
   RUN_TEST(test_Interrupt_InterruptCheck_IsNotSet, 27);
 
+  /* IRQ dispatch */
+  RUN_TEST(test_Irq_RegisterCallback_ReturnsInvalidParam, 29);
+  RUN_TEST(test_Irq_Handler_DispatchesPendingInIndexOrder, 29);
+  RUN_TEST(test_Irq_Handler_AcknowledgesUnregistered, 29);
+  RUN_TEST(test_Irq_Handler_TakesTriggeredInterruptOnce, 29);
+  RUN_TEST(test_Irq_Handler_SkipsCallbackRemovedDuringDispatch, 29);
+
+  /* Periodic alarms */
+  RUN_TEST(test_Periodic_Start_ReturnsInvalidParam, 30);
+  RUN_TEST(test_Periodic_RearmsFromDeadlineNotFromNow, 30);
+  RUN_TEST(test_Periodic_OverrunSkipsMissedPeriods, 30);
+  RUN_TEST(test_Periodic_DeadlineDueNowIsNotSkipped, 30);
+  RUN_TEST(test_Periodic_DeadlineWrapsThroughZero, 30);
+  RUN_TEST(test_Periodic_Stop_DisarmsAndRemovesCallback, 30);
+  RUN_TEST(test_Periodic_Stop_WithdrawsPendingPeriod, 30);
+
+  /* 64 bit deadlines */
+  RUN_TEST(test_Alarm64_ArmAlarmAt64_ReturnsInvalidParam, 31);
+  RUN_TEST(test_Alarm64_ArmAlarmAt64_ArmsInsideWindow, 31);
+  RUN_TEST(test_Alarm64_ArmAlarmAt64_ParksFarDeadline, 31);
+  RUN_TEST(test_Alarm64_DisarmAlarm_ClearsParkedDeadline, 31);
+  RUN_TEST(test_Alarm64_Polled_ExpiryStaysVisible, 31);
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+  /* Latency statistics */
+  RUN_TEST(test_Latency_Snapshot_ReturnsInvalidParam, 33);
+  RUN_TEST(test_Latency_Handler_RecordsLog2Buckets, 33);
+  RUN_TEST(test_Latency_Handler_WrapsThroughZero, 33);
+  RUN_TEST(test_Latency_Handler_SkipsTriggeredInterrupt, 33);
+#endif
+
+  /* Unit conversion */
+  RUN_TEST(test_Conv_Divide32_MatchesReference, 34);
+  RUN_TEST(test_Conv_Multiply_DoesNotOverflow, 34);
+  RUN_TEST(test_Conv_Us64_MatchesReference, 34);
+  RUN_TEST(test_Conv_UDiv32_MatchesReference, 34);
+  RUN_TEST(test_Conv_UDiv64_MatchesReference, 34);
+
+  /* Simulator */
+  RUN_TEST(test_Sim_AlarmMatch_ClearsArmedSetsIntr, 32);
+  RUN_TEST(test_Sim_Ints_MaskedByInte, 32);
+  RUN_TEST(test_Sim_Irq_LevelSensitiveReportsStorm, 32);
+  RUN_TEST(test_Sim_AlarmAtCurrentTime_MatchesNextEpoch, 32);
+  RUN_TEST(test_Sim_Pause_FreezesTime, 32);
+  RUN_TEST(test_Sim_Soak_OneHourOfAlarmsAndSoftTimers, 32);
+
+  /* Deferred work queue */
+  RUN_TEST(test_Defer_Init_ReturnsUninit_TimerNotInit, 30);
+  RUN_TEST(test_Defer_Post_ReturnsInvalidParam, 30);
+  RUN_TEST(test_Defer_Process_RunsInOrderWithTimestamp, 30);
+  RUN_TEST(test_Defer_Post_FailsWhenFull, 30);
+  RUN_TEST(test_Defer_Stress_TwoThreads, 30);
+
+  /* Event trace */
+  RUN_TEST(test_Trace_Init_ReturnsUninit_TimerNotInit, 35);
+  RUN_TEST(test_Trace_Record_DecodesWithDeltaTimestamps, 35);
+  RUN_TEST(test_Trace_Record_DropsOldestWhenFull, 35);
+  RUN_TEST(test_Trace_Reader_RejectsTruncatedImage, 35);
+  RUN_TEST(test_Trace_Sim_RecordsFromAlarmInterrupt, 35);
+
+  /* Profiling */
+  RUN_TEST(test_Prof_Init_ReturnsUninit_TimerNotInit, 36);
+#if ( TIMER_RP2040_PROF != 0 )
+  RUN_TEST(test_Prof_BeginEnd_AccumulatesAcrossWrap, 36);
+  RUN_TEST(test_Prof_Dump_WritesTable, 36);
+#endif
+
+  /* Safe arming */
+  RUN_TEST(test_SafeArm_PassedDeadline_ForcesInterrupt, 37);
+  RUN_TEST(test_SafeArm_Try_ReportsExpired, 37);
+  RUN_TEST(test_SafeArm_ForcedFromBothContexts, 37);
+
+  /* Shadow registers */
+  RUN_TEST(test_Shadow_InterruptEnabled_TracksEnableDisable, 38);
+#if ( TIMER_RP2040_SHADOW != 0 )
+  RUN_TEST(test_Shadow_CheckAlarm_FollowsArmed, 38);
+#endif
+
+  /* Batch alarm status */
+  RUN_TEST(test_CheckAlarms_SnapshotsAllAlarms, 39);
+  RUN_TEST(test_CheckAlarms_AcknowledgesForcedAlarm, 39);
+
+  /* Bitmask arm and disarm */
+  RUN_TEST(test_ArmAlarms_ReturnsInvalidParam, 40);
+  RUN_TEST(test_ArmAlarms_ArmsInLockstep, 40);
+  RUN_TEST(test_DisarmAlarms_DisarmsBitmask, 40);
+
+  /* Relative arm */
+  RUN_TEST(test_ArmAlarmRelative_ReturnsInvalidParam, 41);
+  RUN_TEST(test_ArmAlarmRelative_ArmsFromCurrentTime, 41);
+
+  /* Delays */
+  RUN_TEST(test_Delay_ReturnsUninit_TimerNotInit, 42);
+  RUN_TEST(test_Delay_Us_ReturnsInvalidParam, 42);
+  RUN_TEST(test_Delay_ShortDelaySpins, 42);
+  RUN_TEST(test_Delay_LongDelaySleepsOnAlarm, 42);
+
+  /* Timeouts */
+  RUN_TEST(test_Timeout_ExpiresAcrossWrap, 43);
+  RUN_TEST(test_Timeout64_LongBudget, 43);
+
+#if ( TIMER_RP2040_MULTICORE != 0 )
+  /* Multicore */
+  RUN_TEST(test_Lock_Stress_TwoCores, 31);
+#endif
+
+  /* Scheduler */
+  RUN_TEST(test_Sched_Init_ReturnsUninit_TimerNotInit, 28);
+  RUN_TEST(test_Sched_Start_ReturnsInvalidParam, 28);
+  RUN_TEST(test_Sched_Irq_HandlerProcessesSchedulerAlarm, 28);
+  RUN_TEST(test_Sched_TimeToNext_ReportsNextEvent, 28);
+  RUN_TEST(test_Sched_CatchUpTicks_CountsSkippedTicks, 28);
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+  RUN_TEST(test_Sched_Start_ProgramsEarliestDeadline, 28);
+  RUN_TEST(test_Sched_Stop_EarliestReprogramsNext, 28);
+  RUN_TEST(test_Sched_Start_FailsWhenFull, 28);
+  RUN_TEST(test_Sched_Process_ExpiresDueTimersInOrder, 28);
+  RUN_TEST(test_Sched_Process_FarDeadlineUsesIntermediateWake, 28);
+  RUN_TEST(test_Sched_Window_CoalescesOverlappingTimers, 28);
+#else
+#if ( TIMER_RP2040_TICKLESS == 0 )
+  RUN_TEST(test_Sched_Wheel_Init_ArmsNextTick, 29);
+#endif
+  RUN_TEST(test_Sched_Wheel_ExpiresOnFirstTickAfterDeadline, 29);
+  RUN_TEST(test_Sched_Wheel_StopAndRestart, 29);
+  RUN_TEST(test_Sched_Wheel_Window_MeetsOnAlignedTick, 29);
+#if ( TIMER_RP2040_TICKLESS != 0 )
+  RUN_TEST(test_Sched_Wheel_Tickless_WakesOnlyForWork, 29);
+#endif
+#endif
+
   return (UnityEnd());
 }
@@ -9,6 +9,9 @@
 /* #include "Timer_RP2040.h" */
 #include "Timer_RP2040_Test.h"
 #include "unity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
 
 #pragma ab
 
@@ -16,6 +19,13 @@ void setUp(void)
 {
   Timer_RP2040_Status = TIMER_RP2040_UNINIT;
   Timer_Live = Timer_Uninit;
+  Timer_RP2040_CallbackBitmap = ZERO32;
+  Timer_RP2040_ParkedBitmap = ZERO32;
+  Timer_RP2040_ForcedBitmap = ZERO32;
+  Timer_RP2040_SimStormCount = ZERO32;
+#if ( TIMER_RP2040_SHADOW != 0 )
+  Timer_RP2040_ShadowSync();
+#endif
 }
 
 /* 
@@ -24,7 +34,8 @@ void setUp(void)
 */
 void tearDown(void)
 {
-
+  /* TIMER_IRQ is level sensitive - an interrupt left pending by the handler would starve the target */
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SimIrqStorms());
 }
 
 /* HELPER FUNCTIONS */
@@ -52,6 +63,173 @@ void printTimerLive(void)
   printf("\n");
 }
 
+/* Sets both the latched and the raw time registers of the virtual target */
+void setVirtualTime(uint64 time)
+{
+  Timer_Live.TIMEHR = (uint32)(time >> 32);
+  Timer_Live.TIMELR = (uint32)time;
+  Timer_Live.TIMERAWH = (uint32)(time >> 32);
+  Timer_Live.TIMERAWL = (uint32)time;
+}
+
+/* Soft timer callback - appends the context (an id) to the expiry log */
+uint32 schedExpiryLog[TIMER_RP2040_SCHED_MAX_TIMERS];
+uint32 schedExpiryCount;
+
+void schedLogCallback(void * context)
+{
+  schedExpiryLog[schedExpiryCount] = *(uint32 *)context;
+  schedExpiryCount++;
+}
+
+/* Alarm callback - appends the alarm index and the context (an id) to the dispatch log */
+uint32 irqDispatchLog[2 * (ALARM_MAX_INDEX + 1)];
+uint32 irqDispatchCount;
+
+void irqLogCallback(uint8 alarmIndex, void * context)
+{
+  irqDispatchLog[irqDispatchCount] = alarmIndex;
+  irqDispatchLog[irqDispatchCount + 1] = *(uint32 *)context;
+  irqDispatchCount += 2;
+}
+
+/* Deferred function - appends the context (an id) and the timestamp to the defer log */
+uint32 deferLog[2 * TIMER_RP2040_DEFER_CAPACITY];
+uint32 deferCount;
+
+void deferLogFunction(void * context, uint32 timestamp)
+{
+  deferLog[deferCount] = *(uint32 *)context;
+  deferLog[deferCount + 1] = timestamp;
+  deferCount += 2;
+}
+
+/* Deferred queue stress test - one producer thread and one consumer thread */
+#define DEFER_STRESS_ENTRIES 200000uL
+#define DEFER_STRESS_CONTEXTS 1024uL
+
+uint32 deferStressContext[DEFER_STRESS_CONTEXTS];
+uint32 deferStressErrors;
+
+void * deferStressProducer(void * arg)
+{
+  uint32 i;
+  (void)arg;
+
+  for( i = 0; i < DEFER_STRESS_ENTRIES; i++ )
+  {
+    /* TIMERAWL doubles as the sequence number, so the consumer can check order and completeness */
+    Timer_Live.TIMERAWL = i;
+    while( E_OK != Timer_RP2040_DeferPost(deferLogFunction, &deferStressContext[i % DEFER_STRESS_CONTEXTS]) )
+    {
+      (void)sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+void * deferStressConsumer(void * arg)
+{
+  uint32 expected = 0;
+  tTimer_RP2040_DeferEntry entry;
+  (void)arg;
+
+  while( expected < DEFER_STRESS_ENTRIES )
+  {
+    if( E_OK == Timer_RP2040_DeferPop(&entry) )
+    {
+      if( (entry.timestamp != expected) ||
+          (entry.context != &deferStressContext[expected % DEFER_STRESS_CONTEXTS]) ||
+          (entry.function != deferLogFunction) )
+      {
+        deferStressErrors++;
+      }
+      expected++;
+    }
+    else
+    {
+      (void)sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+#if ( TIMER_RP2040_MULTICORE != 0 )
+/*
+  Multicore stress test - each thread plays one core and owns one alarm and its interrupt enable bit. Registers and
+  bitmaps shared with the other thread are read with atomic loads. Besides INTE (lock-free alias updates), the test
+  checks the parked bitmap, which both cores update with read-modify-writes under the driver lock (so it is read under
+  that lock as well), that ALARMn and ARMED are set after each arm and that ARMED is clear after each disarm.
+*/
+#define LOCK_STRESS_ITERATIONS 1000000uL
+
+/* Beyond the comparator window, so the deadline is parked */
+#define LOCK_STRESS_FAR_DEADLINE ((uint64)TIMER_RP2040_ALARM_WINDOW_US * 4u)
+
+#define LOCK_STRESS_LOAD(word) __atomic_load_n(&(word), __ATOMIC_SEQ_CST)
+
+uint32 lockStressErrors[2];
+
+/* The parked bitmap is driver state - read it under the lock that guards it */
+uint32 lockStressParked(void)
+{
+  uint32 lockState;
+  uint32 parked;
+
+  TIMER_RP2040_LOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+  parked = Timer_RP2040_ParkedBitmap;
+  TIMER_RP2040_UNLOCK(TIMER_RP2040_LOCK_DRIVER, lockState);
+
+  return parked;
+}
+
+void * lockStressCore(void * arg)
+{
+  uint32 i;
+  uint8 alarmIndex = *(uint8 *)arg;
+  uint32 bit = INT_TO_BITMAP(alarmIndex);
+  volatile uint32 * alarm = TIMER_REG_PTR(TIMER_REG_ALARMn(alarmIndex));
+
+  for( i = 0; i < LOCK_STRESS_ITERATIONS; i++ )
+  {
+    (void)Timer_RP2040_InterruptEnable(bit);
+    if( 0 == (LOCK_STRESS_LOAD(Timer_Live.INTE) & bit) )
+    {
+      lockStressErrors[alarmIndex]++;
+    }
+
+    (void)Timer_RP2040_ArmAlarmAt64(alarmIndex, LOCK_STRESS_FAR_DEADLINE);
+    if( 0 == (lockStressParked() & bit) )
+    {
+      lockStressErrors[alarmIndex]++;
+    }
+
+    (void)Timer_RP2040_ArmAlarmN(alarmIndex, i + 1uL);
+    if( ((i + 1uL) != *alarm) || (0 == (LOCK_STRESS_LOAD(Timer_Live.ARMED) & bit)) ||
+        (0 != (lockStressParked() & bit)) )
+    {
+      lockStressErrors[alarmIndex]++;
+    }
+
+    (void)Timer_RP2040_DisarmAlarmN(alarmIndex);
+    if( 0 != (LOCK_STRESS_LOAD(Timer_Live.ARMED) & bit) )
+    {
+      lockStressErrors[alarmIndex]++;
+    }
+
+    (void)Timer_RP2040_InterruptDisable(bit);
+    if( 0 != (LOCK_STRESS_LOAD(Timer_Live.INTE) & bit) )
+    {
+      lockStressErrors[alarmIndex]++;
+    }
+  }
+
+  return NULL;
+}
+#endif
+
 /* TESTS */
 
 void test_Init_ReturnsOK(void)
@@ -358,6 +536,9 @@ void test_Alarm_CheckAlarm_0Set(void)
   Timer_RP2040_Status = TIMER_RP2040_INIT;
   Timer_Live.ALARM0 = 0xFACEBEEF;
   Timer_Live.ARMED =  0x00000001;
+#if ( TIMER_RP2040_SHADOW != 0 )
+  Timer_RP2040_ShadowSync();
+#endif
 
   retVal = Timer_RP2040_CheckAlarmN(0x0);
 
@@ -375,6 +556,9 @@ void test_Alarm_CheckAlarm_nSet(void)
   Timer_Live.ALARM3 = 0xCACACACA;
   Timer_Live.ARMED =  0x0000000F;
   int i;
+#if ( TIMER_RP2040_SHADOW != 0 )
+  Timer_RP2040_ShadowSync();
+#endif
 
   for( i = 0; i <= ALARM_MAX_INDEX; i++)
   {
@@ -396,6 +580,7 @@ void test_Alarm_CheckAlarm_0Triggered(void)
   */
   
   Timer_Live.ALARM0 = 0x0;
+  Timer_Live.INTR = 0x00000001;
   Timer_Live.INTS = 0x00000001;
 
   retVal = Timer_RP2040_CheckAlarmN(0x0);
@@ -419,6 +604,7 @@ void test_Alarm_CheckAlarm_nTriggered(void)
   Timer_Live.ALARM1 = 0x0;
   Timer_Live.ALARM2 = 0x0;
   Timer_Live.ALARM3 = 0x0;
+  Timer_Live.INTR = 0x0000000F;
   Timer_Live.INTS = 0x0000000F;
 
   for( i = 0; i <= ALARM_MAX_INDEX; i++)
@@ -443,8 +629,60 @@ void test_Alarm_CheckAlarm_InvalidIndex(void)
 
 }
 
+void test_Alarm_CheckAlarm_ArmedAtZero(void)
+{
+  uint8 i;
+
+  for( i = 0; i <= ALARM_MAX_INDEX; i++ )
+  {
+    Timer_RP2040_SimReset(0xFFFFFF00uLL);
+    Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+    /* 0 is a valid trigger time - here just after the wrap */
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(i, ZERO32));
+    TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(i));
+
+    (void)Timer_RP2040_SimAdvance(0x100);
+    TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_TRIGGERED, Timer_RP2040_CheckAlarmN(i));
+
+    (void)Timer_RP2040_InterruptClearN(i);
+    TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(i));
+  }
+}
+
+void test_Alarm_CheckAlarm_RearmReleasesForced(void)
+{
+  uint32 triggers[4] = { 900, 900, 900, 900 };
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  /* Polled alarm armed late: the expiry is forced */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 900));
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  /* The new deadline has not been reached, the old expiry must not show through */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 5000));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(ZERO32, Timer_RP2040_ForcedBitmap);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  /* Same for the lockstep arm */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarms(0xC, triggers));
+  TEST_ASSERT_EQUAL(0xC, Timer_Live.INTF);
+  triggers[2] = 5000;
+  triggers[3] = 5000;
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarms(0xC, triggers));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(ZERO32, Timer_RP2040_ForcedBitmap);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM2_INDEX));
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM3_INDEX));
+
+  (void)Timer_RP2040_DisarmAlarms(TIMER_RP2040_ALLALARMS_BITMASK);
+}
+
 /* Alarm Writes */
-void test_Alarm_SetAlarm0_With0_Fails(void)
+void test_Alarm_SetAlarm0_With0_Arms(void)
 {
   /* Set the module to Init */
   Std_ErrorCode retVal = E_NOT_OK;
@@ -452,7 +690,7 @@ void test_Alarm_SetAlarm0_With0_Fails(void)
 
   retVal = Timer_RP2040_ArmAlarmN(0, ZERO32);
 
-  TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+  TEST_ASSERT_EQUAL(E_OK, retVal);
 }
 
 void test_Alarm_SetAlarm0_WithN(void)
@@ -477,7 +715,7 @@ void test_Alarm_SetAlarm0_WithOnes(void)
   TEST_ASSERT_EQUAL(E_OK, retVal);
 }
 
-void test_Alarm_SetAlarmN_With0_Fails(void)
+void test_Alarm_SetAlarmN_With0_Arms(void)
 {
   /* Set the module to Init */
   Std_ErrorCode retVal = E_NOT_OK;
@@ -488,10 +726,10 @@ void test_Alarm_SetAlarmN_With0_Fails(void)
   {
     retVal = E_NOT_OK;
     retVal = Timer_RP2040_ArmAlarmN(i, 0x0);
-    TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+    TEST_ASSERT_EQUAL(E_OK, retVal);
   }
 
-  TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+  TEST_ASSERT_EQUAL(E_OK, retVal);
 }
 
 void test_Alarm_SetAlarmN_WithN(void)
@@ -576,8 +814,9 @@ void test_Alarm_DisarmAlarm_0WasSetIsNotSet(void)
   retVal = Timer_RP2040_DisarmAlarmN(alarmIndex);
 
   TEST_ASSERT_EQUAL(E_OK, retVal);
-  TEST_ASSERT_EQUAL(0x0, Timer_Live.ALARM0);
-  /* ARMED is not checked because that is hadnled in hardware cirtcuit*/
+  /* ALARMn keeps its value - 0 is a valid trigger time, ARMED alone tells a disarmed alarm */
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(alarmIndex));
 }
 
 void test_Alarm_DisarmAlarm_nWasNotSetStillNotSet(void)
@@ -612,8 +851,9 @@ void test_Alarm_DisarmAlarm_nWasSetIsNotSet(void)
   retVal = Timer_RP2040_DisarmAlarmN(alarmIndex);
 
   TEST_ASSERT_EQUAL(E_OK, retVal);
-  TEST_ASSERT_EQUAL(0x0, Timer_Live.ALARM1);
-  /* ARMED is not checked because that is hadnled in hardware cirtcuit*/
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(alarmIndex));
+  /* ARMED is write-1-to-clear, the model clears only the written bit */
+  TEST_ASSERT_EQUAL(0x1, Timer_Live.ARMED);
 }
 
 void test_Alarm_DisarmAlarm_0WasNotSetStillNotSet_nNotTouched(void)
@@ -649,9 +889,9 @@ void test_Alarm_DisarmAlarm_0WasSetIsNotSet_nNotTouched(void)
   retVal = Timer_RP2040_DisarmAlarmN(alarmIndex);
 
   TEST_ASSERT_EQUAL(E_OK, retVal);
-  TEST_ASSERT_EQUAL(0x0, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(alarmIndex));
   TEST_ASSERT_EQUAL(0xFACEBEEF, Timer_Live.ALARM1);
-  /* ARMED is not checked because that is hadnled in hardware cirtcuit*/
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.ARMED);
 }
 
 /* TIMERAW reads */
@@ -680,6 +920,81 @@ void test_TIMERAW_ReadTIMERAWL_ReturnsOKWithN(void)
   TEST_ASSERT_EQUAL(0xFACEBEEF, time);
 }
 
+void test_TIMERAW_Read64_CombinesRAWHandRAWL(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_Live.TIMERAWH = 0x00000012;
+  Timer_Live.TIMERAWL = 0xFACEBEEF;
+
+  TEST_ASSERT_EQUAL_UINT64((((uint64)0x00000012uL << 32) | 0xFACEBEEFuL), Timer_RP2040_TimerRead64());
+}
+
+void test_TIMERAW_Read64_DoesNotUseLatchedRegisters(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_UNINIT;
+  Timer_Live.TIMEHR = 0xDEADBEEF;
+  Timer_Live.TIMELR = 0xDEADBEEF;
+  Timer_Live.TIMERAWH = 0xFFFFFFFF;
+  Timer_Live.TIMERAWL = 0x00000001;
+
+  TEST_ASSERT_EQUAL_UINT64((((uint64)0xFFFFFFFFuL << 32) | 0x00000001uL), Timer_RP2040_TimerRead64());
+  TEST_ASSERT_EQUAL(0xDEADBEEF, Timer_Live.TIMEHR);
+  TEST_ASSERT_EQUAL(0xDEADBEEF, Timer_Live.TIMELR);
+}
+
+void test_TIMERAW_Now32_ReadsTIMERAWL(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_Live.TIMERAWH = 0x00000012;
+  Timer_Live.TIMERAWL = 0xFACEBEEF;
+
+  TEST_ASSERT_EQUAL_UINT32(0xFACEBEEF, Timer_RP2040_Now32());
+}
+
+void test_TIMERAW_Now64_CombinesRAWHandRAWL(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_Live.TIMERAWH = 0x00000012;
+  Timer_Live.TIMERAWL = 0xFACEBEEF;
+
+  TEST_ASSERT_EQUAL_UINT64((((uint64)0x00000012uL << 32) | 0xFACEBEEFuL), Timer_RP2040_Now64());
+}
+
+void test_TIMERAW_Elapsed32_AcrossWrap(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_Live.TIMERAWL = 0x00000010;
+
+  TEST_ASSERT_EQUAL_UINT32(0x20, Timer_RP2040_Elapsed32(0xFFFFFFF0));
+}
+
+#if ( TIMER_RP2040_DEBUG != 0 )
+void test_TIMERAW_Now32_Debug_ReturnsZeroWhenUninit(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_UNINIT;
+  Timer_Live.TIMERAWL = 0xFACEBEEF;
+
+  TEST_ASSERT_EQUAL_UINT32(0, Timer_RP2040_Now32());
+  TEST_ASSERT_EQUAL_UINT64(0, Timer_RP2040_Now64());
+}
+
+void test_TIMERAW_Debug_ArmDecisionsUseRawTime(void)
+{
+  Timer_RP2040_SimReset(5000);
+  Timer_RP2040_Status = TIMER_RP2040_UNINIT;
+
+  /* Passed deadlines are still seen as passed before Init, although Timer_RP2040_Now32 reads 0 */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 4999));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.INTF);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmAt64(ALARM2_INDEX, 6000));
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_RP2040_ParkedBitmap);
+  TEST_ASSERT_EQUAL(6000, Timer_Live.ALARM2);
+}
+#endif
+
 /* INTR */ /* INTR is Raw Interrupts - this must be written to to service an interrupt */
 void test_Interrupt_InterruptClear_ReturnsOK(void)
 {
@@ -707,11 +1022,12 @@ void test_Interrupt_InterruptClear_ClearsInterrupt(void)
   Std_ErrorCode retVal = E_NOT_OK;
   Timer_RP2040_Status = TIMER_RP2040_INIT;
 
-  Timer_Live.INTR = 0x0000000;
+  /* INTR is write-1-to-clear */
+  Timer_Live.INTR = 0x1;
   retVal = Timer_RP2040_InterruptClearN(0x0);
 
   TEST_ASSERT_EQUAL(E_OK, retVal);
-  TEST_ASSERT_EQUAL(0x1, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
 }
 
 void test_Interrupt_InterruptClear_ClearsInterruptDoesNotClearOthers(void)
@@ -723,7 +1039,7 @@ void test_Interrupt_InterruptClear_ClearsInterruptDoesNotClearOthers(void)
   retVal = Timer_RP2040_InterruptClearN(0x0);
 
   TEST_ASSERT_EQUAL(E_OK, retVal);
-  TEST_ASSERT_EQUAL(0x9, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0x8, Timer_Live.INTR);
 }
 
 /* INTE */ /* INTE is Interrupt Enable Mask */
@@ -881,5 +1197,1804 @@ void test_Interrupt_InterruptCheck_IsNotSet(void)
   TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, retVal);
 }
 
+/* IRQ dispatch */
+void test_Irq_RegisterCallback_ReturnsInvalidParam(void)
+{
+  Std_ErrorCode retVal = E_NOT_OK;
+
+  retVal = Timer_RP2040_RegisterCallback(ALARM_MAX_INDEX + 1, irqLogCallback, NULL);
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+}
+
+void test_Irq_Handler_DispatchesPendingInIndexOrder(void)
+{
+  uint32 ids[3] = { 10, 11, 12 };
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_RegisterCallback(ALARM0_INDEX, irqLogCallback, &ids[0]));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_RegisterCallback(ALARM1_INDEX, irqLogCallback, &ids[1]));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_RegisterCallback(ALARM2_INDEX, irqLogCallback, &ids[2]));
+  Timer_Live.INTR = 0xD;
+  Timer_Live.INTS = 0x5;
+
+  Timer_RP2040_IrqHandler();
+
+  /* Both serviced flags are acknowledged in one INTR write */
+  TEST_ASSERT_EQUAL(0x8, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(4, irqDispatchCount);
+  TEST_ASSERT_EQUAL(ALARM0_INDEX, irqDispatchLog[0]);
+  TEST_ASSERT_EQUAL(10, irqDispatchLog[1]);
+  TEST_ASSERT_EQUAL(ALARM2_INDEX, irqDispatchLog[2]);
+  TEST_ASSERT_EQUAL(12, irqDispatchLog[3]);
+}
+
+void test_Irq_Handler_AcknowledgesUnregistered(void)
+{
+  uint32 id = 21;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, irqLogCallback, &id);
+  (void)Timer_RP2040_RegisterCallback(ALARM3_INDEX, irqLogCallback, &id);
+  (void)Timer_RP2040_RegisterCallback(ALARM3_INDEX, NULL, NULL);
+  Timer_Live.INTR = 0xB;
+  Timer_Live.INTS = 0xB;
+
+  Timer_RP2040_IrqHandler();
+
+  /* TIMER_IRQ is level sensitive - a flag left set would re-enter the handler at once */
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+  /* The unregistered alarms are handed over to polling */
+  TEST_ASSERT_EQUAL(0x9, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM3_INDEX));
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  TEST_ASSERT_EQUAL(ALARM1_INDEX, irqDispatchLog[0]);
+  TEST_ASSERT_EQUAL(21, irqDispatchLog[1]);
+}
+
+void test_Irq_Handler_TakesTriggeredInterruptOnce(void)
+{
+  uint32 id = 22;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, irqLogCallback, &id);
+  (void)Timer_RP2040_InterruptNTrigger(ALARM1_INDEX);
+  Timer_Live.INTS = 0x2;
+
+  Timer_RP2040_IrqHandler();
+
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, NULL, NULL);
+}
+
+void test_Irq_Handler_SkipsCallbackRemovedDuringDispatch(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  /* The other core removed the callback after the handler sampled the bitmap */
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, NULL, NULL);
+  Timer_RP2040_CallbackBitmap = INT_TO_BITMAP(ALARM2_INDEX);
+  Timer_Live.INTR = 0x4;
+  Timer_Live.INTS = 0x4;
+
+  Timer_RP2040_IrqHandler();
+
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0, irqDispatchCount);
+}
+
+/* Periodic alarms */
+void test_Periodic_Start_ReturnsInvalidParam(void)
+{
+  uint32 id = 1;
+
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 1000, irqLogCallback, &id));
+
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_PeriodicStart(ALARM_MAX_INDEX + 1, 1000, irqLogCallback, &id));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 0, irqLogCallback, &id));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 0x80000000uL, irqLogCallback, &id));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 1000, NULL, &id));
+}
+
+void test_Periodic_RearmsFromDeadlineNotFromNow(void)
+{
+  uint32 id = 31;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+  setVirtualTime(500);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 1000, irqLogCallback, &id));
+  TEST_ASSERT_EQUAL(1500, Timer_Live.ALARM1);
+
+  /* Serviced 37us late - the next deadline is still 2500 */
+  setVirtualTime(1537);
+  Timer_Live.INTS = INT_TO_BITMAP(ALARM1_INDEX);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(2500, Timer_Live.ALARM1);
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  TEST_ASSERT_EQUAL(ALARM1_INDEX, irqDispatchLog[0]);
+  TEST_ASSERT_EQUAL(31, irqDispatchLog[1]);
+
+  setVirtualTime(2510);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(3500, Timer_Live.ALARM1);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_PeriodicSkipped(ALARM1_INDEX));
+}
+
+void test_Periodic_OverrunSkipsMissedPeriods(void)
+{
+  uint32 id = 32;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+  setVirtualTime(0);
+
+  (void)Timer_RP2040_PeriodicStart(ALARM2_INDEX, 100, irqLogCallback, &id);
+
+  /* Serviced at 350 - the deadlines 200 and 300 have passed, the alarm stays in phase at 400 */
+  setVirtualTime(350);
+  Timer_Live.INTS = INT_TO_BITMAP(ALARM2_INDEX);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(400, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(2, Timer_RP2040_PeriodicSkipped(ALARM2_INDEX));
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+}
+
+void test_Periodic_DeadlineDueNowIsNotSkipped(void)
+{
+  uint32 id = 34;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+  setVirtualTime(0);
+
+  (void)Timer_RP2040_PeriodicStart(ALARM2_INDEX, 100, irqLogCallback, &id);
+
+  /* Serviced at 200 - the deadline 200 is due, not missed: it is armed and its interrupt forced */
+  setVirtualTime(200);
+  Timer_Live.INTS = INT_TO_BITMAP(ALARM2_INDEX);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(200, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_PeriodicSkipped(ALARM2_INDEX));
+  TEST_ASSERT_EQUAL(INT_TO_BITMAP(ALARM2_INDEX), Timer_Live.INTF);
+
+  /* The forced interrupt runs the period of 200 */
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(300, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(4, irqDispatchCount);
+
+  /* The period of 300 serviced at 500 - 400 is missed, 500 is due and armed */
+  setVirtualTime(500);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(500, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_PeriodicSkipped(ALARM2_INDEX));
+  (void)Timer_RP2040_PeriodicStop(ALARM2_INDEX);
+}
+
+void test_Periodic_DeadlineWrapsThroughZero(void)
+{
+  uint32 id = 33;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0xFFFFFF00uL);
+
+  (void)Timer_RP2040_PeriodicStart(ALARM0_INDEX, 0x80, irqLogCallback, &id);
+  TEST_ASSERT_EQUAL(0xFFFFFF80uL, Timer_Live.ALARM0);
+
+  setVirtualTime(0xFFFFFF81uL);
+  Timer_Live.INTS = INT_TO_BITMAP(ALARM0_INDEX);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0, Timer_Live.ALARM0);
+
+  setVirtualTime(0x100000002uLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0x80, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_PeriodicSkipped(ALARM0_INDEX));
+}
+
+void test_Periodic_Stop_DisarmsAndRemovesCallback(void)
+{
+  uint32 id = 34;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+
+  (void)Timer_RP2040_PeriodicStart(ALARM3_INDEX, 1000, irqLogCallback, &id);
+  Timer_Live.ARMED = INT_TO_BITMAP(ALARM3_INDEX);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_PeriodicStop(ALARM3_INDEX));
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(ALARM3_INDEX));
+  TEST_ASSERT_EQUAL(0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_CallbackBitmap);
+}
+
+void test_Periodic_Stop_WithdrawsPendingPeriod(void)
+{
+  uint32 id = 35;
+  void * periodic;
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM1_INDEX));
+  (void)Timer_RP2040_PeriodicStart(ALARM1_INDEX, 100, irqLogCallback, &id);
+  periodic = Timer_RP2040_CallbackContext[ALARM1_INDEX];
+
+  /* A period matched just before Stop - its interrupt would be left without a callback */
+  Timer_Live.INTR = INT_TO_BITMAP(ALARM1_INDEX);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_PeriodicStop(ALARM1_INDEX));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+
+  /* A handler which copied the registration before Stop neither re-arms the alarm nor runs the callback */
+  Timer_RP2040_PeriodicIrq(ALARM1_INDEX, periodic);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(0, irqDispatchCount);
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_PeriodicStop(ALARM_MAX_INDEX + 1));
+}
+
+/* 64 bit deadlines */
+void test_Alarm64_ArmAlarmAt64_ReturnsInvalidParam(void)
+{
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarmAt64(ALARM_MAX_INDEX + 1, 1000));
+}
+
+void test_Alarm64_ArmAlarmAt64_ArmsInsideWindow(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0x100000010uLL);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmAt64(ALARM1_INDEX, 0x100001000uLL));
+  TEST_ASSERT_EQUAL(0x1000, Timer_Live.ALARM1);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_ParkedBitmap);
+}
+
+void test_Alarm64_ArmAlarmAt64_ParksFarDeadline(void)
+{
+  uint32 id = 41;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+  setVirtualTime(0);
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, irqLogCallback, &id);
+
+  /* Three 31 bit windows away - the low word alone would fire in the first epoch */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmAt64(ALARM2_INDEX, 0x180000000uLL));
+  TEST_ASSERT_EQUAL(0x7FFFFFFFuL, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(INT_TO_BITMAP(ALARM2_INDEX), Timer_RP2040_ParkedBitmap);
+
+  /* Intermediate wakes re-arm without reaching the callback */
+  Timer_Live.INTS = INT_TO_BITMAP(ALARM2_INDEX);
+  setVirtualTime(0x7FFFFFFFuLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0xFFFFFFFEuL, Timer_Live.ALARM2);
+
+  setVirtualTime(0xFFFFFFFEuLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0x7FFFFFFDuL, Timer_Live.ALARM2);
+
+  /* The deadline is inside the window now and armed on its low word */
+  setVirtualTime(0x17FFFFFFDuLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0x80000000uL, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_ParkedBitmap);
+  TEST_ASSERT_EQUAL(0, irqDispatchCount);
+
+  setVirtualTime(0x180000000uLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  TEST_ASSERT_EQUAL(41, irqDispatchLog[1]);
+}
+
+void test_Alarm64_DisarmAlarm_ClearsParkedDeadline(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+
+  (void)Timer_RP2040_ArmAlarmAt64(ALARM3_INDEX, 0x300000000uLL);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DisarmAlarmN(ALARM3_INDEX));
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_ParkedBitmap);
+}
+
+void test_Alarm64_Polled_ExpiryStaysVisible(void)
+{
+  tTimer_RP2040_AlarmSnapshot snapshot;
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  /* No callback - the interrupt is only enabled for the intermediate wakes */
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM1_INDEX));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmAt64(ALARM1_INDEX, 0x180000000uLL));
+  TEST_ASSERT_EQUAL(INT_TO_BITMAP(ALARM1_INDEX), Timer_RP2040_ParkedBitmap);
+
+  (void)Timer_RP2040_SimAdvanceTo(0x17FFFFFFFuLL);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  /* The expiry is handed over to polling instead of being acknowledged and lost */
+  (void)Timer_RP2040_SimAdvanceTo(0x180000000uLL);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTE);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 1));
+  TEST_ASSERT_EQUAL(INT_TO_BITMAP(ALARM1_INDEX), snapshot.fired);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+}
+
+#if ( TIMER_RP2040_LATENCY_STATS != 0 )
+/* Latency statistics - raises alarm 'alarmIndex' at 'time' with ALARMn holding 'deadline' */
+void latencyFire(uint8 alarmIndex, uint32 deadline, uint64 time)
+{
+  TIMER_REG_WRITE(TIMER_REG_ALARMn(alarmIndex), deadline);
+#if ( TIMER_RP2040_SHADOW != 0 )
+  Timer_RP2040_ShadowSync();
+#endif
+  setVirtualTime(time);
+  Timer_Live.INTR = INT_TO_BITMAP(alarmIndex);
+  Timer_Live.INTS = INT_TO_BITMAP(alarmIndex);
+  Timer_RP2040_IrqHandler();
+}
+
+void test_Latency_Snapshot_ReturnsInvalidParam(void)
+{
+  tTimer_RP2040_LatencyStats stats;
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_LatencySnapshot(ALARM_MAX_INDEX + 1, &stats));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_LatencySnapshot(ALARM0_INDEX, NULL));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_LatencyReset(ALARM_MAX_INDEX + 1));
+}
+
+void test_Latency_Handler_RecordsLog2Buckets(void)
+{
+  tTimer_RP2040_LatencyStats stats;
+  uint32 id = 40;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  (void)Timer_RP2040_LatencyReset(ALARM1_INDEX);
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, irqLogCallback, &id);
+  latencyFire(ALARM1_INDEX, 1000, 1000);
+  latencyFire(ALARM1_INDEX, 2000, 2005);
+  latencyFire(ALARM1_INDEX, 3000, 3001);
+  latencyFire(ALARM1_INDEX, 4000, 4100);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_LatencySnapshot(ALARM1_INDEX, &stats));
+  TEST_ASSERT_EQUAL(8, irqDispatchCount);
+  TEST_ASSERT_EQUAL(4, stats.count);
+  TEST_ASSERT_EQUAL(0, stats.min);
+  TEST_ASSERT_EQUAL(100, stats.max);
+  TEST_ASSERT_EQUAL(26, stats.mean);
+  TEST_ASSERT_EQUAL(1, stats.bucket[0]);
+  TEST_ASSERT_EQUAL(1, stats.bucket[1]);
+  TEST_ASSERT_EQUAL(1, stats.bucket[3]);
+  TEST_ASSERT_EQUAL(1, stats.bucket[7]);
+
+  /* Other alarms are not affected */
+  (void)Timer_RP2040_LatencyReset(ALARM2_INDEX);
+  (void)Timer_RP2040_LatencySnapshot(ALARM2_INDEX, &stats);
+  TEST_ASSERT_EQUAL(0, stats.count);
+  TEST_ASSERT_EQUAL(0, stats.mean);
+}
+
+void test_Latency_Handler_WrapsThroughZero(void)
+{
+  tTimer_RP2040_LatencyStats stats;
+  uint32 id = 41;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  (void)Timer_RP2040_LatencyReset(ALARM3_INDEX);
+  (void)Timer_RP2040_RegisterCallback(ALARM3_INDEX, irqLogCallback, &id);
+  irqDispatchCount = 0;
+  latencyFire(ALARM3_INDEX, 0xFFFFFFF0uL, 0x100000005uLL);
+
+  (void)Timer_RP2040_LatencySnapshot(ALARM3_INDEX, &stats);
+  TEST_ASSERT_EQUAL(1, stats.count);
+  TEST_ASSERT_EQUAL(0x15, stats.max);
+  TEST_ASSERT_EQUAL(1, stats.bucket[5]);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_LatencyReset(ALARM3_INDEX));
+  (void)Timer_RP2040_LatencySnapshot(ALARM3_INDEX, &stats);
+  TEST_ASSERT_EQUAL(0, stats.count);
+  TEST_ASSERT_EQUAL(0, stats.bucket[5]);
+}
+
+void test_Latency_Handler_SkipsTriggeredInterrupt(void)
+{
+  tTimer_RP2040_LatencyStats stats;
+  uint32 id = 42;
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+
+  (void)Timer_RP2040_LatencyReset(ALARM2_INDEX);
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM2_INDEX));
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, irqLogCallback, &id);
+
+  /* A trigger dispatches the callback, but there is no deadline to measure against */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_InterruptNTrigger(ALARM2_INDEX));
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  (void)Timer_RP2040_LatencySnapshot(ALARM2_INDEX, &stats);
+  TEST_ASSERT_EQUAL(0, stats.count);
+  (void)Timer_RP2040_InterruptClearN(ALARM2_INDEX);
+
+  /* A missed deadline forced by the driver is measured */
+  (void)Timer_RP2040_ArmAlarmN(ALARM2_INDEX, 990);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(4, irqDispatchCount);
+  (void)Timer_RP2040_LatencySnapshot(ALARM2_INDEX, &stats);
+  TEST_ASSERT_EQUAL(1, stats.count);
+  TEST_ASSERT_EQUAL(10, stats.max);
+
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, NULL, NULL);
+}
+#endif
+
+/* Unit conversion - checks a 32 bit divider against C division on a prime stride, the top of the range, and both
+   sides of every multiple of the divisor near the top. The bench verifies all 2^32 inputs. */
+uint32 convMismatch(uint32 (*convert)(uint32), uint32 divisor)
+{
+  uint32 mismatches = 0;
+  uint32 value = 0;
+  uint32 multiple;
 
+  do
+  {
+    mismatches += (convert(value) != (value / divisor)) ? 1 : 0;
+    value += 9973uL;
+  } while( value >= 9973uL );
 
+  for( value = 0xFFFFFFFFuL; value >= 0xFFFF0000uL; value-- )
+  {
+    mismatches += (convert(value) != (value / divisor)) ? 1 : 0;
+  }
+
+  for( multiple = (0xFFFFFFFFuL / divisor) * divisor; multiple > (0xFFFFFFFFuL - (1000uL * divisor));
+       multiple -= divisor )
+  {
+    mismatches += (convert(multiple) != (multiple / divisor)) ? 1 : 0;
+    mismatches += (convert(multiple - 1uL) != ((multiple - 1uL) / divisor)) ? 1 : 0;
+  }
+
+  return mismatches;
+}
+
+void test_Conv_Divide32_MatchesReference(void)
+{
+  TEST_ASSERT_EQUAL(0, convMismatch(Timer_RP2040_UsToMs, 1000uL));
+  TEST_ASSERT_EQUAL(0, convMismatch(Timer_RP2040_MsToS, 1000uL));
+  TEST_ASSERT_EQUAL(0, convMismatch(Timer_RP2040_UsToS, 1000000uL));
+  TEST_ASSERT_EQUAL(0, convMismatch(Timer_RP2040_SToMin, 60uL));
+  TEST_ASSERT_EQUAL(4294967, Timer_RP2040_UsToMs(0xFFFFFFFFuL));
+  TEST_ASSERT_EQUAL(71582788, Timer_RP2040_SToMin(0xFFFFFFFFuL));
+}
+
+void test_Conv_Multiply_DoesNotOverflow(void)
+{
+  TEST_ASSERT_TRUE(Timer_RP2040_MsToUs(0xFFFFFFFFuL) == 4294967295000uLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_SToMs(0xFFFFFFFFuL) == 4294967295000uLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_MinToS(0xFFFFFFFFuL) == 257698037700uLL);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_MsToUs(0));
+}
+
+void test_Conv_Us64_MatchesReference(void)
+{
+  uint64 value = 0x123456789ABCDEFuLL;
+  uint32 mismatches = 0;
+  uint32 i;
+
+  for( i = 0; i < 100000uL; i++ )
+  {
+    /* 64 bit LCG, shifted so that every magnitude is covered */
+    value = (value * 6364136223846793005uLL) + 1442695040888963407uLL;
+    mismatches += (Timer_RP2040_Us64ToMs(value >> (i & 63)) != ((value >> (i & 63)) / 1000uLL)) ? 1 : 0;
+    mismatches += (Timer_RP2040_Us64ToS(value >> (i & 63)) != ((value >> (i & 63)) / 1000000uLL)) ? 1 : 0;
+  }
+
+  TEST_ASSERT_EQUAL(0, mismatches);
+  TEST_ASSERT_TRUE(Timer_RP2040_Us64ToMs(0xFFFFFFFFFFFFFFFFuLL) == 18446744073709551uLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_Us64ToS(0xFFFFFFFFFFFFFFFFuLL) == 18446744073709uLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_Us64ToMs(999) == 0);
+  TEST_ASSERT_TRUE(Timer_RP2040_Us64ToS(0x100000000uLL) == 4294);
+}
+
+void test_Conv_UDiv32_MatchesReference(void)
+{
+  TEST_ASSERT_EQUAL(0x7FFFFFFFuL, Timer_RP2040_UDiv32(0xFFFFFFFFuL, 2));
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_UDiv32(6, 7));
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_UDiv32(0xFFFFFFFFuL, 0xFFFFFFFFuL));
+}
+
+void test_Conv_UDiv64_MatchesReference(void)
+{
+  uint64 value = 0xFEDCBA9876543210uLL;
+  uint32 divisor;
+  uint32 mismatches = 0;
+  uint32 i;
+
+  for( i = 0; i < 100000uL; i++ )
+  {
+    value = (value * 6364136223846793005uLL) + 1442695040888963407uLL;
+    /* Divisors of every width, including those >= 2^16 that the limb division cannot take */
+    divisor = (uint32)(value >> 32) >> (i & 31);
+    divisor = (ZERO32 == divisor) ? 1 : divisor;
+    mismatches += (Timer_RP2040_UDiv64(value >> (i & 63), divisor) != ((value >> (i & 63)) / divisor)) ? 1 : 0;
+  }
+
+  TEST_ASSERT_EQUAL(0, mismatches);
+  TEST_ASSERT_TRUE(Timer_RP2040_UDiv64(0xFFFFFFFFFFFFFFFFuLL, 0xFFFFFFFFuL) == 0x100000001uLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_UDiv64(0xFFFFFFFFFFFFFFFFuLL, 1) == 0xFFFFFFFFFFFFFFFFuLL);
+  TEST_ASSERT_TRUE(Timer_RP2040_UDiv64(0x80000000uL, 0x80000001uL) == 0);
+}
+
+/* Simulator */
+uint32 simPeriodicCount;
+tTimer_RP2040_SoftTimer simChainTimer;
+uint32 simChainCount;
+
+void simPeriodicCallback(uint8 alarmIndex, void * context)
+{
+  (void)alarmIndex;
+  (void)context;
+  simPeriodicCount++;
+}
+
+/* Soft timer callback - restarts itself 7ms after its own deadline */
+void simChainCallback(void * context)
+{
+  (void)context;
+  simChainCount++;
+  (void)Timer_RP2040_SchedStart(&simChainTimer, simChainTimer.deadline + 7000, simChainCallback, NULL);
+}
+
+void test_Sim_AlarmMatch_ClearsArmedSetsIntr(void)
+{
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM1_INDEX));
+
+  (void)Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 1000);
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL_UINT64(1000, Timer_RP2040_SimNextEvent());
+
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SimAdvanceTo(999));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(999, Timer_Live.TIMERAWL);
+
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_SimAdvance(1));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.INTS);
+  TEST_ASSERT_EQUAL(1000, Timer_Live.TIMELR);
+  TEST_ASSERT_EQUAL_UINT64(TIMER_RP2040_SIM_NO_EVENT, Timer_RP2040_SimNextEvent());
+
+  /* INTR is write-1-to-clear and INTS follows it */
+  (void)Timer_RP2040_InterruptClearN(ALARM1_INDEX);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+}
+
+void test_Sim_Ints_MaskedByInte(void)
+{
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM2_INDEX));
+
+  /* A match on a disabled interrupt is raw only */
+  (void)Timer_RP2040_ArmAlarmN(ALARM0_INDEX, 10);
+  (void)Timer_RP2040_SimAdvance(10);
+  TEST_ASSERT_EQUAL(0x1, Timer_Live.INTR);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+
+  /* A forced interrupt shows in INTS */
+  (void)Timer_RP2040_InterruptNTrigger(ALARM2_INDEX);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.INTS);
+}
+
+/* Interrupt handler which never acknowledges anything */
+uint32 simDeafCount;
+
+void simDeafHandler(void)
+{
+  simDeafCount++;
+}
+
+void test_Sim_Irq_LevelSensitiveReportsStorm(void)
+{
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_SimSetIrq(simDeafHandler);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  simDeafCount = 0;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM1_INDEX));
+
+  /* The handler is re-entered while INTS stays set, although it does not change */
+  (void)Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 10);
+  (void)Timer_RP2040_SimAdvance(10);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_SIM_MAX_IRQ_NESTING, simDeafCount);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_SimIrqStorms());
+
+  /* The driver's handler takes it at once */
+  simDeafCount = 0;
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_SimIrqStorms());
+
+  Timer_RP2040_SimReset(0);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SimIrqStorms());
+}
+
+void test_Sim_AlarmAtCurrentTime_MatchesNextEpoch(void)
+{
+  Timer_RP2040_SimReset(5000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  /* Raw comparator write - Timer_RP2040_ArmAlarmN forces the interrupt instead */
+  TIMER_REG_ALARM_WRITE(ALARM3_INDEX, 5000);
+
+  TEST_ASSERT_EQUAL_UINT64(5000 + 0x100000000uLL, Timer_RP2040_SimNextEvent());
+}
+
+void test_Sim_Pause_FreezesTime(void)
+{
+  Timer_RP2040_SimReset(100);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_ArmAlarmN(ALARM0_INDEX, 200);
+  Timer_Live.PAUSE = TIMER_PAUSE_SET;
+
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SimAdvance(1000));
+  TEST_ASSERT_EQUAL_UINT64(100, Timer_RP2040_SimNow());
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_SimStep());
+}
+
+void test_Sim_Soak_OneHourOfAlarmsAndSoftTimers(void)
+{
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  (void)Timer_RP2040_InterruptEnable(TIMER_RP2040_ALLINTERRUPTS_BITMASK);
+  simPeriodicCount = 0;
+  simChainCount = 0;
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedInit());
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_PeriodicStart(ALARM1_INDEX, 1000, simPeriodicCallback, NULL));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&simChainTimer, 7000, simChainCallback, NULL));
+
+  (void)Timer_RP2040_SimAdvanceTo(3600000000uLL);
+
+  /* 1kHz for an hour, exactly, and a 7ms soft timer chain without drift */
+  TEST_ASSERT_EQUAL(3600000, simPeriodicCount);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_PeriodicSkipped(ALARM1_INDEX));
+  TEST_ASSERT_EQUAL(3600000000uL / 7000uL, simChainCount);
+  TEST_ASSERT_EQUAL_UINT64(3600000000uLL, Timer_RP2040_SimNow());
+}
+
+/* Deferred work queue */
+void test_Defer_Init_ReturnsUninit_TimerNotInit(void)
+{
+  Timer_RP2040_DeferStatus = TIMER_RP2040_UNINIT;
+
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_DeferInit());
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_DeferPost(deferLogFunction, NULL));
+}
+
+void test_Defer_Post_ReturnsInvalidParam(void)
+{
+  tTimer_RP2040_DeferEntry entry;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_DeferInit();
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_DeferPost(NULL, NULL));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_DeferPop(NULL));
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_DeferPop(&entry));
+}
+
+void test_Defer_Process_RunsInOrderWithTimestamp(void)
+{
+  uint32 ids[3] = { 1, 2, 3 };
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_DeferInit();
+  deferCount = 0;
+
+  Timer_Live.TIMERAWL = 100;
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DeferPost(deferLogFunction, &ids[0]));
+  Timer_Live.TIMERAWL = 200;
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DeferPost(deferLogFunction, &ids[1]));
+  Timer_Live.TIMERAWL = 300;
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DeferPost(deferLogFunction, &ids[2]));
+
+  TEST_ASSERT_EQUAL(2, Timer_RP2040_DeferProcess(2));
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_DeferProcess(10));
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_DeferProcess(10));
+
+  TEST_ASSERT_EQUAL(6, deferCount);
+  TEST_ASSERT_EQUAL(1, deferLog[0]);
+  TEST_ASSERT_EQUAL(100, deferLog[1]);
+  TEST_ASSERT_EQUAL(2, deferLog[2]);
+  TEST_ASSERT_EQUAL(200, deferLog[3]);
+  TEST_ASSERT_EQUAL(3, deferLog[4]);
+  TEST_ASSERT_EQUAL(300, deferLog[5]);
+}
+
+void test_Defer_Post_FailsWhenFull(void)
+{
+  uint32 i;
+  uint32 id = 0;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_DeferInit();
+
+  for( i = 0; i < TIMER_RP2040_DEFER_CAPACITY; i++ )
+  {
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DeferPost(deferLogFunction, &id));
+  }
+
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_DeferPost(deferLogFunction, &id));
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_DeferDropped());
+}
+
+void test_Defer_Stress_TwoThreads(void)
+{
+  pthread_t producer;
+  pthread_t consumer;
+  tTimer_RP2040_DeferEntry entry;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_DeferInit();
+  deferStressErrors = 0;
+
+  TEST_ASSERT_EQUAL(0, pthread_create(&consumer, NULL, deferStressConsumer, NULL));
+  TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, deferStressProducer, NULL));
+  (void)pthread_join(producer, NULL);
+  (void)pthread_join(consumer, NULL);
+
+  TEST_ASSERT_EQUAL(0, deferStressErrors);
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_DeferPop(&entry));
+}
+
+/* Event trace */
+uint8 traceImage[TIMER_RP2040_TRACE_HEADER_BYTES + TIMER_RP2040_TRACE_BYTES];
+
+/* Alarm callback - records the alarm index as event and the callback count as argument */
+void traceAlarmCallback(uint8 alarmIndex, void * context)
+{
+  uint32 * count = (uint32 *)context;
+
+  (void)Timer_RP2040_TraceRecord(alarmIndex, *count);
+  *count = *count + 1;
+}
+
+void test_Trace_Init_ReturnsUninit_TimerNotInit(void)
+{
+  uint32 length;
+  Timer_RP2040_TraceStatus = TIMER_RP2040_UNINIT;
+
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_TraceInit());
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_TraceRecord(1, 2));
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_TraceExport(traceImage, sizeof(traceImage), &length));
+}
+
+void test_Trace_Record_DecodesWithDeltaTimestamps(void)
+{
+  tTimer_RP2040_TraceReader reader;
+  tTimer_RP2040_TraceEvent event;
+  uint32 length;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0xFFFFFF00uLL);
+  (void)Timer_RP2040_TraceInit();
+
+  setVirtualTime(0xFFFFFF10uLL);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceRecord(7, 0));
+  setVirtualTime(0x100000200uLL);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceRecord(8, 300));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceRecord(255, 0xFFFFFFFFuL));
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceExport(traceImage, sizeof(traceImage), &length));
+  /* 3 + 5 + 7 bytes of records against 3 * 13 bytes of raw 64 bit stamps */
+  TEST_ASSERT_EQUAL(TIMER_RP2040_TRACE_HEADER_BYTES + 15, length);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceReaderInit(&reader, traceImage, length));
+  TEST_ASSERT_EQUAL(0, reader.dropped);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceNext(&reader, &event));
+  TEST_ASSERT_TRUE(0xFFFFFF10uLL == event.time);
+  TEST_ASSERT_EQUAL(7, event.id);
+  TEST_ASSERT_EQUAL(0, event.argument);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceNext(&reader, &event));
+  TEST_ASSERT_TRUE(0x100000200uLL == event.time);
+  TEST_ASSERT_EQUAL(8, event.id);
+  TEST_ASSERT_EQUAL(300, event.argument);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceNext(&reader, &event));
+  TEST_ASSERT_TRUE(0x100000200uLL == event.time);
+  TEST_ASSERT_EQUAL(255, event.id);
+  TEST_ASSERT_EQUAL(0xFFFFFFFFuL, event.argument);
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_TraceNext(&reader, &event));
+}
+
+void test_Trace_Record_DropsOldestWhenFull(void)
+{
+  tTimer_RP2040_TraceReader reader;
+  tTimer_RP2040_TraceEvent event;
+  uint32 length;
+  uint32 i;
+  uint32 decoded = 0;
+  uint32 errors = 0;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_TraceInit();
+
+  /* 1000us apart: 2 byte delta, id, 2 byte argument */
+  for( i = 1; i <= TIMER_RP2040_TRACE_BYTES; i++ )
+  {
+    setVirtualTime((uint64)i * 1000uLL);
+    (void)Timer_RP2040_TraceRecord((uint8)i, 1000uL + i);
+  }
+
+  TEST_ASSERT_EQUAL(TIMER_RP2040_TRACE_BYTES - (TIMER_RP2040_TRACE_BYTES / 5), Timer_RP2040_TraceDropped());
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_TraceExport(traceImage, TIMER_RP2040_TRACE_BYTES, &length));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceExport(traceImage, sizeof(traceImage), &length));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceReaderInit(&reader, traceImage, length));
+  TEST_ASSERT_EQUAL(Timer_RP2040_TraceDropped(), reader.dropped);
+
+  /* Every retained record still carries its absolute time */
+  i = reader.dropped + 1;
+  while( E_OK == Timer_RP2040_TraceNext(&reader, &event) )
+  {
+    errors += (event.time != ((uint64)i * 1000uLL)) ? 1 : 0;
+    errors += (event.id != (uint8)i) ? 1 : 0;
+    errors += (event.argument != (1000uL + i)) ? 1 : 0;
+    decoded++;
+    i++;
+  }
+
+  TEST_ASSERT_EQUAL(0, errors);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_TRACE_BYTES / 5, decoded);
+}
+
+void test_Trace_Reader_RejectsTruncatedImage(void)
+{
+  tTimer_RP2040_TraceReader reader;
+  tTimer_RP2040_TraceEvent event;
+  uint32 length;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_TraceInit();
+  setVirtualTime(1000);
+  (void)Timer_RP2040_TraceRecord(1, 1000);
+  (void)Timer_RP2040_TraceExport(traceImage, sizeof(traceImage), &length);
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_TraceReaderInit(&reader, traceImage, length - 1));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_TraceReaderInit(&reader, traceImage, 4));
+
+  /* A record cut inside its argument */
+  traceImage[8] = (uint8)(length - TIMER_RP2040_TRACE_HEADER_BYTES - 1);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceReaderInit(&reader, traceImage, length - 1));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_TraceNext(&reader, &event));
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_TraceNext(&reader, &event));
+}
+
+void test_Trace_Sim_RecordsFromAlarmInterrupt(void)
+{
+  tTimer_RP2040_TraceReader reader;
+  tTimer_RP2040_TraceEvent event;
+  uint32 length;
+  uint32 count = 0;
+  uint32 decoded = 0;
+  uint32 errors = 0;
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_TraceInit());
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM2_INDEX));
+  (void)Timer_RP2040_PeriodicStart(ALARM2_INDEX, 1000, traceAlarmCallback, &count);
+
+  (void)Timer_RP2040_SimAdvance(50000);
+
+  (void)Timer_RP2040_TraceExport(traceImage, sizeof(traceImage), &length);
+  (void)Timer_RP2040_TraceReaderInit(&reader, traceImage, length);
+  while( E_OK == Timer_RP2040_TraceNext(&reader, &event) )
+  {
+    errors += (event.time != ((uint64)(decoded + 1) * 1000uLL)) ? 1 : 0;
+    errors += (event.id != ALARM2_INDEX) ? 1 : 0;
+    errors += (event.argument != decoded) ? 1 : 0;
+    decoded++;
+  }
+
+  TEST_ASSERT_EQUAL(50, decoded);
+  TEST_ASSERT_EQUAL(0, errors);
+  Timer_RP2040_SimSetIrq(NULL);
+}
+
+/* Profiling */
+char profDumpLines[4][TIMER_RP2040_PROF_LINE_MAX];
+uint32 profDumpCount;
+
+void profDumpOutput(const char * line)
+{
+  (void)strcpy(profDumpLines[profDumpCount], line);
+  profDumpCount++;
+}
+
+void test_Prof_Init_ReturnsUninit_TimerNotInit(void)
+{
+  tTimer_RP2040_ProfStats stats;
+
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_ProfInit());
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ProfRead(TIMER_RP2040_PROF_SITES, &stats));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ProfRead(0, NULL));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ProfDump(NULL));
+}
+
+#if ( TIMER_RP2040_PROF != 0 )
+void test_Prof_BeginEnd_AccumulatesAcrossWrap(void)
+{
+  tTimer_RP2040_ProfStats stats;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ProfInit());
+
+  setVirtualTime(1000);
+  Timer_RP2040_ProfBegin(3);
+  setVirtualTime(1010);
+  Timer_RP2040_ProfEnd(3);
+
+  /* Section across the wrap of TIMERAWL */
+  setVirtualTime(0xFFFFFFF0uLL);
+  Timer_RP2040_ProfBegin(3);
+  setVirtualTime(0x100000010uLL);
+  Timer_RP2040_ProfEnd(3);
+
+  setVirtualTime(0x100000100uLL);
+  Timer_RP2040_ProfBegin(3);
+  Timer_RP2040_ProfEnd(3);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ProfRead(3, &stats));
+  TEST_ASSERT_EQUAL(3, stats.count);
+  TEST_ASSERT_TRUE(42 == stats.total);
+  TEST_ASSERT_EQUAL(0, stats.min);
+  TEST_ASSERT_EQUAL(32, stats.max);
+  TEST_ASSERT_EQUAL(14, stats.mean);
+
+  /* Unused sites report zeros */
+  (void)Timer_RP2040_ProfRead(4, &stats);
+  TEST_ASSERT_EQUAL(0, stats.count);
+  TEST_ASSERT_EQUAL(0, stats.min);
+}
+
+void test_Prof_Dump_WritesTable(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_ProfInit();
+  profDumpCount = 0;
+
+  setVirtualTime(0);
+  Timer_RP2040_ProfBegin(1);
+  setVirtualTime(1234567);
+  Timer_RP2040_ProfEnd(1);
+  Timer_RP2040_ProfBegin(12);
+  setVirtualTime(1234567 + 1000);
+  Timer_RP2040_ProfEnd(12);
+  Timer_RP2040_ProfSite[12].count = 12345678;
+  Timer_RP2040_ProfSite[12].total = 12345678901234uLL;
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ProfDump(profDumpOutput));
+  TEST_ASSERT_EQUAL(3, profDumpCount);
+  TEST_ASSERT_EQUAL_STRING("site      count         total_us    min_us    max_us   mean_us", profDumpLines[0]);
+  TEST_ASSERT_EQUAL_STRING("   1          1          1234567   1234567   1234567   1234567", profDumpLines[1]);
+  TEST_ASSERT_EQUAL_STRING("  12   12345678   12345678901234      1000      1000   1000000", profDumpLines[2]);
+}
+#endif
+
+/* Safe arming */
+uint32 safeArmCount = 0;
+
+void safeArmCallback(void * context)
+{
+  (void)context;
+  safeArmCount++;
+}
+
+void test_SafeArm_PassedDeadline_ForcesInterrupt(void)
+{
+  Timer_RP2040_SimReset(5000);
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  safeArmCount = 0;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM2_INDEX));
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, safeArmCallback, NULL);
+
+  /* Already passed - the comparator would only match after a wrap, so the interrupt is forced instead */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM2_INDEX, 4999));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL_UINT64(TIMER_RP2040_SIM_NO_EVENT, Timer_RP2040_SimNextEvent());
+
+  /* Serviced like a match, and the force does not outlive it */
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SimAdvance(0));
+  TEST_ASSERT_EQUAL(1, safeArmCount);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(0x0, Timer_RP2040_ForcedBitmap);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+
+  /* A deadline in the future arms the comparator as before */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM2_INDEX, 5001));
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL_UINT64(5001, Timer_RP2040_SimNextEvent());
+
+  (void)Timer_RP2040_RegisterCallback(ALARM2_INDEX, NULL, NULL);
+}
+
+void test_SafeArm_Try_ReportsExpired(void)
+{
+  Timer_RP2040_SimReset(0x10);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_FAILED, Timer_RP2040_TryArmAlarmN(ALARM_MAX_INDEX + 1, 0));
+
+  /* 0 is a valid deadline - here it is 16 us in the past */
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_EXPIRED, Timer_RP2040_TryArmAlarmN(ALARM1_INDEX, ZERO32));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_TryArmAlarmN(ALARM1_INDEX, 0x11));
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.ARMED);
+
+  /* Disarming withdraws a forced interrupt that was not serviced yet */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmAt64(ALARM3_INDEX, 0x10));
+  TEST_ASSERT_EQUAL(0x8, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DisarmAlarmN(ALARM3_INDEX));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(0x0, Timer_RP2040_ForcedBitmap);
+}
+
+/* Alarm callback - arms ALARM2 with a passed deadline, forcing its interrupt from interrupt context */
+void safeArmForceCallback(uint8 alarmIndex, void * context)
+{
+  (void)alarmIndex;
+  (void)context;
+  (void)Timer_RP2040_ArmAlarmN(ALARM2_INDEX, Timer_RP2040_Now32() - 1uL);
+}
+
+void test_SafeArm_ForcedFromBothContexts(void)
+{
+  tTimer_RP2040_AlarmSnapshot snapshot;
+  uint32 id = 1;
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  irqDispatchCount = 0;
+  (void)Timer_RP2040_InterruptEnable(0x3);
+  (void)Timer_RP2040_RegisterCallback(ALARM0_INDEX, safeArmForceCallback, NULL);
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, irqLogCallback, &id);
+
+  /* Forced from thread mode */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM0_INDEX, 999));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 999));
+  TEST_ASSERT_EQUAL(0x3, Timer_RP2040_ForcedBitmap);
+  TEST_ASSERT_EQUAL(0x3, Timer_Live.INTF);
+
+  /* Released by the handler, which forces ALARM2 from its callback - polled, so it stays pending */
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(2, irqDispatchCount);
+  TEST_ASSERT_EQUAL(0x4, Timer_RP2040_ForcedBitmap);
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 0));
+  TEST_ASSERT_EQUAL(0x0, snapshot.armed);
+  TEST_ASSERT_EQUAL(0x4, snapshot.fired);
+
+  /* Released from thread mode */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DisarmAlarmN(ALARM2_INDEX));
+  TEST_ASSERT_EQUAL(0x0, Timer_RP2040_ForcedBitmap);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 0));
+  TEST_ASSERT_EQUAL(0x0, snapshot.fired);
+
+  (void)Timer_RP2040_RegisterCallback(ALARM0_INDEX, NULL, NULL);
+  (void)Timer_RP2040_RegisterCallback(ALARM1_INDEX, NULL, NULL);
+}
+
+/* Shadow registers */
+void test_Shadow_InterruptEnabled_TracksEnableDisable(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  TEST_ASSERT_EQUAL(0x0, Timer_RP2040_InterruptEnabled());
+  (void)Timer_RP2040_InterruptEnable(0x5);
+  TEST_ASSERT_EQUAL(0x5, Timer_RP2040_InterruptEnabled());
+  (void)Timer_RP2040_InterruptDisable(0x4);
+  TEST_ASSERT_EQUAL(0x1, Timer_RP2040_InterruptEnabled());
+  TEST_ASSERT_EQUAL(0x1, Timer_Live.INTE);
+}
+
+#if ( TIMER_RP2040_SHADOW != 0 )
+void test_Shadow_CheckAlarm_FollowsArmed(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 0x1234));
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  /* The ALARMn value, shadowed or not, does not decide the status - 0 is a valid trigger time */
+  Timer_Live.ALARM1 = ZERO32;
+  Timer_RP2040_ShadowSync();
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_SET_NOT_TRIGGERED, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  /* ARMED is hardware owned and still read from the TIMER - a match is seen straight away */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 0x1234));
+  Timer_Live.ARMED = ZERO32;
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+}
+#endif
+
+/* Batch alarm status */
+void test_CheckAlarms_SnapshotsAllAlarms(void)
+{
+  tTimer_RP2040_AlarmSnapshot snapshot;
+  Timer_RP2040_SimReset(0);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM1_INDEX));
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_CheckAlarms(NULL, 0));
+
+  (void)Timer_RP2040_ArmAlarmN(ALARM0_INDEX, 100);
+  (void)Timer_RP2040_ArmAlarmN(ALARM1_INDEX, 200);
+  (void)Timer_RP2040_ArmAlarmN(ALARM2_INDEX, 5000);
+  (void)Timer_RP2040_SimAdvanceTo(250);
+
+  /* Alarm 0 fired with its interrupt disabled, alarm 1 fired and is pending, alarm 2 is still armed */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 0));
+  TEST_ASSERT_EQUAL(0x4, snapshot.armed);
+  TEST_ASSERT_EQUAL(0x3, snapshot.fired);
+  TEST_ASSERT_EQUAL(0x2, snapshot.pending);
+  TEST_ASSERT_EQUAL(0x3, Timer_Live.INTR);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 1));
+  TEST_ASSERT_EQUAL(0x3, snapshot.fired);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 0));
+  TEST_ASSERT_EQUAL(0x4, snapshot.armed);
+  TEST_ASSERT_EQUAL(0x0, snapshot.fired);
+  TEST_ASSERT_EQUAL(0x0, snapshot.pending);
+}
+
+void test_CheckAlarms_AcknowledgesForcedAlarm(void)
+{
+  tTimer_RP2040_AlarmSnapshot snapshot;
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_InterruptEnable(INT_TO_BITMAP(ALARM3_INDEX));
+
+  /* Armed in the past - the interrupt is forced, there is no comparator match in INTR */
+  (void)Timer_RP2040_ArmAlarmN(ALARM3_INDEX, 900);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_CheckAlarms(&snapshot, 1));
+  TEST_ASSERT_EQUAL(0x0, snapshot.armed);
+  TEST_ASSERT_EQUAL(0x8, snapshot.fired);
+  TEST_ASSERT_EQUAL(0x8, snapshot.pending);
+
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTS);
+}
+
+/* Bitmask arm and disarm */
+void test_ArmAlarms_ReturnsInvalidParam(void)
+{
+  uint32 triggers[4] = { 100, 200, 300, 400 };
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarms(0x0, triggers));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarms(0x10, triggers));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarms(0x1, NULL));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_DisarmAlarms(0x0));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_DisarmAlarms(0x1F));
+}
+
+void test_ArmAlarms_ArmsInLockstep(void)
+{
+  uint32 triggers[4] = { 0xFFFFFFFF, 2000, 2000, 900 };
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  safeArmCount = 0;
+  (void)Timer_RP2040_InterruptEnable(TIMER_RP2040_ALLALARMS_BITMASK);
+  (void)Timer_RP2040_RegisterCallback(ALARM3_INDEX, safeArmCallback, NULL);
+
+  /* Alarm 0 is left alone, alarm 3 is already late */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarms(0xE, triggers));
+  TEST_ASSERT_EQUAL(0x6, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(2000, Timer_Live.ALARM1);
+  TEST_ASSERT_EQUAL(2000, Timer_Live.ALARM2);
+  TEST_ASSERT_EQUAL(0x8, Timer_Live.INTF);
+
+  (void)Timer_RP2040_SimAdvance(0);
+  TEST_ASSERT_EQUAL(1, safeArmCount);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  (void)Timer_RP2040_SimAdvanceTo(1999);
+  TEST_ASSERT_EQUAL(0x6, Timer_Live.ARMED);
+
+  /* Both comparators match on the same tick */
+  TEST_ASSERT_EQUAL(2, Timer_RP2040_SimAdvance(1));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+
+  (void)Timer_RP2040_RegisterCallback(ALARM3_INDEX, NULL, NULL);
+}
+
+void test_DisarmAlarms_DisarmsBitmask(void)
+{
+  uint32 triggers[4] = { 5000, 5000, 5000, 100 };
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_InterruptEnable(TIMER_RP2040_ALLALARMS_BITMASK);
+
+  (void)Timer_RP2040_ArmAlarms(TIMER_RP2040_ALLALARMS_BITMASK, triggers);
+  TEST_ASSERT_EQUAL(0x7, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x8, Timer_Live.INTF);
+
+  /* The forced interrupt of alarm 3 is withdrawn with the alarm */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DisarmAlarms(0xA));
+  TEST_ASSERT_EQUAL(0x5, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(ALARM1_INDEX));
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DisarmAlarms(TIMER_RP2040_ALLALARMS_BITMASK));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+}
+
+/* Relative arm */
+void test_ArmAlarmRelative_ReturnsInvalidParam(void)
+{
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarmRelative(ALARM_MAX_INDEX + 1, 100, NULL));
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_ArmAlarmRelative(ALARM0_INDEX, TIMER_RP2040_HALF_RANGE32, NULL));
+}
+
+void test_ArmAlarmRelative_ArmsFromCurrentTime(void)
+{
+  uint32 triggerTime = ZERO32;
+  Timer_RP2040_SimReset(0xFFFFFF00);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  /* The deadline wraps past 2^32 */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmRelative(ALARM1_INDEX, 0x200, &triggerTime));
+  TEST_ASSERT_EQUAL(0x100, triggerTime);
+  TEST_ASSERT_EQUAL(0x100, Timer_Live.ALARM1);
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTF);
+
+  /* A delta of 0 has passed by the time the write lands */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_ArmAlarmRelative(ALARM2_INDEX, 0, NULL));
+  TEST_ASSERT_EQUAL(0x2, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0x4, Timer_Live.INTF);
+
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_SimAdvance(0x200));
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+  (void)Timer_RP2040_DisarmAlarmN(ALARM2_INDEX);
+}
+
+/* Delays */
+void test_Delay_ReturnsUninit_TimerNotInit(void)
+{
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_DelayInit());
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_DelayUs(1));
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, Timer_RP2040_DelayUntil(0));
+}
+
+void test_Delay_Us_ReturnsInvalidParam(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_DelayUs(TIMER_RP2040_HALF_RANGE32));
+}
+
+void test_Delay_ShortDelaySpins(void)
+{
+  Timer_RP2040_SimReset(1000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayUs(7));
+  TEST_ASSERT_EQUAL_UINT64(1007, Timer_RP2040_SimNow());
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayUs(0));
+  TEST_ASSERT_EQUAL_UINT64(1007, Timer_RP2040_SimNow());
+
+  /* Without Timer_RP2040_DelayInit long delays spin as well */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayUs(TIMER_RP2040_DELAY_SLEEP_US + 100));
+  TEST_ASSERT_EQUAL_UINT64(1107 + TIMER_RP2040_DELAY_SLEEP_US, Timer_RP2040_SimNow());
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.ARMED);
+}
+
+void test_Delay_LongDelaySleepsOnAlarm(void)
+{
+  Timer_RP2040_SimReset(0xFFFFF000);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  Timer_RP2040_SimSetIrq(Timer_RP2040_IrqHandler);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayInit());
+  TEST_ASSERT_EQUAL(INT_TO_BITMAP(TIMER_RP2040_DELAY_ALARM), Timer_Live.INTE);
+
+  /* Sleeps across the wrap until the wake margin, then spins to the deadline */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayUs(0x2000));
+  TEST_ASSERT_EQUAL_UINT64(0x100001000uLL, Timer_RP2040_SimNow());
+  TEST_ASSERT_EQUAL(0x1000 - TIMER_RP2040_DELAY_WAKE_US, Timer_Live.ALARM3);
+  TEST_ASSERT_EQUAL(0x0, Timer_Live.INTR);
+
+  /* A passed deadline returns at once */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_DelayUntil(0x800));
+  TEST_ASSERT_EQUAL_UINT64(0x100001000uLL, Timer_RP2040_SimNow());
+
+  (void)Timer_RP2040_RegisterCallback(TIMER_RP2040_DELAY_ALARM, NULL, NULL);
+  Timer_RP2040_DelayStatus = TIMER_RP2040_UNINIT;
+}
+
+/* Timeouts */
+void test_Timeout_ExpiresAcrossWrap(void)
+{
+  tTimer_RP2040_Timeout timeout;
+  Timer_RP2040_SimReset(0xFFFFFF00);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  Timer_RP2040_TimeoutStart(&timeout, 0x200);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_TimeoutExpired(&timeout));
+  TEST_ASSERT_EQUAL(0x200, Timer_RP2040_TimeoutRemaining(&timeout));
+
+  (void)Timer_RP2040_SimAdvance(0x1FF);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_TimeoutExpired(&timeout));
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_TimeoutRemaining(&timeout));
+
+  (void)Timer_RP2040_SimAdvance(1);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_TimeoutExpired(&timeout));
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_TimeoutRemaining(&timeout));
+
+  /* Still expired when checked long after */
+  (void)Timer_RP2040_SimAdvance(0x7FFFFFFF);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_TimeoutExpired(&timeout));
+}
+
+void test_Timeout64_LongBudget(void)
+{
+  tTimer_RP2040_Timeout64 timeout;
+  Timer_RP2040_SimReset(0x1FFFF0000uLL);
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+
+  /* Longer than the 32 bit counter range */
+  Timer_RP2040_TimeoutStart64(&timeout, 0x100000000uLL);
+  (void)Timer_RP2040_SimAdvance(0xFFFFFFFFuLL);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_TimeoutExpired64(&timeout));
+  TEST_ASSERT_EQUAL_UINT64(1, Timer_RP2040_TimeoutRemaining64(&timeout));
+
+  (void)Timer_RP2040_SimAdvance(1);
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_TimeoutExpired64(&timeout));
+  TEST_ASSERT_EQUAL_UINT64(0, Timer_RP2040_TimeoutRemaining64(&timeout));
+}
+
+#if ( TIMER_RP2040_MULTICORE != 0 )
+/* Multicore */
+void test_Lock_Stress_TwoCores(void)
+{
+  pthread_t cores[2];
+  uint8 alarms[2] = { ALARM0_INDEX, ALARM1_INDEX };
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  lockStressErrors[0] = 0;
+  lockStressErrors[1] = 0;
+
+  TEST_ASSERT_EQUAL(0, pthread_create(&cores[0], NULL, lockStressCore, &alarms[0]));
+  TEST_ASSERT_EQUAL(0, pthread_create(&cores[1], NULL, lockStressCore, &alarms[1]));
+  (void)pthread_join(cores[0], NULL);
+  (void)pthread_join(cores[1], NULL);
+
+  TEST_ASSERT_EQUAL(0, lockStressErrors[0]);
+  TEST_ASSERT_EQUAL(0, lockStressErrors[1]);
+  TEST_ASSERT_EQUAL(0, Timer_Live.INTE);
+  TEST_ASSERT_EQUAL(0, Timer_Live.ARMED);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_ParkedBitmap);
+}
+#endif
+
+/* Scheduler */
+void test_Sched_Init_ReturnsUninit_TimerNotInit(void)
+{
+  Std_ErrorCode retVal = E_NOT_OK;
+
+  retVal = Timer_RP2040_SchedInit();
+
+  TEST_ASSERT_EQUAL(E_MODULE_UNINIT, retVal);
+}
+
+void test_Sched_Start_ReturnsInvalidParam(void)
+{
+  Std_ErrorCode retVal = E_NOT_OK;
+  static tTimer_RP2040_SoftTimer timer;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+
+  retVal = Timer_RP2040_SchedStart(NULL, 1000, schedLogCallback, NULL);
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+
+  retVal = Timer_RP2040_SchedStart(&timer, 1000, NULL, NULL);
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, retVal);
+}
+
+void test_Sched_Irq_HandlerProcessesSchedulerAlarm(void)
+{
+  static tTimer_RP2040_SoftTimer timer;
+  uint32 id = 7;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  schedExpiryCount = 0;
+  (void)Timer_RP2040_SchedInit();
+  (void)Timer_RP2040_SchedStart(&timer, 100, schedLogCallback, &id);
+
+  setVirtualTime(5000);
+  Timer_Live.INTS = INT_TO_BITMAP(TIMER_RP2040_SCHED_ALARM_INDEX);
+  Timer_RP2040_IrqHandler();
+
+  TEST_ASSERT_EQUAL(1, schedExpiryCount);
+  TEST_ASSERT_EQUAL(7, schedExpiryLog[0]);
+}
+
+void test_Sched_TimeToNext_ReportsNextEvent(void)
+{
+  static tTimer_RP2040_SoftTimer timer;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(1000);
+  (void)Timer_RP2040_SchedInit();
+
+  TEST_ASSERT_EQUAL_UINT64(TIMER_RP2040_SCHED_NO_DEADLINE, Timer_RP2040_SchedTimeToNext());
+
+  (void)Timer_RP2040_SchedStart(&timer, 5000, schedLogCallback, NULL);
+  TEST_ASSERT_EQUAL_UINT64(4000, Timer_RP2040_SchedTimeToNext());
+
+  /* Overdue work is reported as due now */
+  setVirtualTime(6000);
+  TEST_ASSERT_EQUAL_UINT64(0, Timer_RP2040_SchedTimeToNext());
+}
+
+void test_Sched_CatchUpTicks_CountsSkippedTicks(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+
+  setVirtualTime(7500);
+  TEST_ASSERT_EQUAL(7, Timer_RP2040_SchedCatchUpTicks());
+
+  /* No new tick boundary yet */
+  setVirtualTime(7999);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SchedCatchUpTicks());
+
+  setVirtualTime(12000);
+  TEST_ASSERT_EQUAL(5, Timer_RP2040_SchedCatchUpTicks());
+}
+
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_HEAP )
+void test_Sched_Start_ProgramsEarliestDeadline(void)
+{
+  static tTimer_RP2040_SoftTimer timers[3];
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[0], 5000, schedLogCallback, NULL));
+  TEST_ASSERT_EQUAL(5000, Timer_Live.ALARM0);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[1], 2000, schedLogCallback, NULL));
+  TEST_ASSERT_EQUAL(2000, Timer_Live.ALARM0);
+
+  /* A later deadline does not move the alarm */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[2], 9000, schedLogCallback, NULL));
+  TEST_ASSERT_EQUAL(2000, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL(3, Timer_RP2040_SchedCount);
+}
+
+void test_Sched_Stop_EarliestReprogramsNext(void)
+{
+  static tTimer_RP2040_SoftTimer timers[3];
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+
+  (void)Timer_RP2040_SchedStart(&timers[0], 5000, schedLogCallback, NULL);
+  (void)Timer_RP2040_SchedStart(&timers[1], 2000, schedLogCallback, NULL);
+  (void)Timer_RP2040_SchedStart(&timers[2], 9000, schedLogCallback, NULL);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStop(&timers[1]));
+  TEST_ASSERT_EQUAL(5000, Timer_Live.ALARM0);
+  TEST_ASSERT_FALSE(Timer_RP2040_SchedIsActive(&timers[1]));
+
+  /* Stopping an idle timer is not an error */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStop(&timers[1]));
+  TEST_ASSERT_EQUAL(2, Timer_RP2040_SchedCount);
+}
+
+void test_Sched_Start_FailsWhenFull(void)
+{
+  static tTimer_RP2040_SoftTimer timers[TIMER_RP2040_SCHED_MAX_TIMERS + 1];
+  int i;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+
+  for( i = 0; i < TIMER_RP2040_SCHED_MAX_TIMERS; i++ )
+  {
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[i], 1000 + i, schedLogCallback, NULL));
+  }
+
+  TEST_ASSERT_EQUAL(E_NOT_OK, Timer_RP2040_SchedStart(&timers[i], 1000, schedLogCallback, NULL));
+  TEST_ASSERT_FALSE(Timer_RP2040_SchedIsActive(&timers[i]));
+
+  /* Init drops everything */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedInit());
+  TEST_ASSERT_FALSE(Timer_RP2040_SchedIsActive(&timers[0]));
+}
+
+void test_Sched_Process_ExpiresDueTimersInOrder(void)
+{
+  static tTimer_RP2040_SoftTimer timers[TIMER_RP2040_SCHED_MAX_TIMERS];
+  static uint32 ids[TIMER_RP2040_SCHED_MAX_TIMERS];
+  uint32 seed = 12345;
+  uint64 lastDeadline = 0;
+  int i;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  /* Pseudo random deadlines, some of them repeated */
+  for( i = 0; i < TIMER_RP2040_SCHED_MAX_TIMERS; i++ )
+  {
+    seed = (seed * 1103515245uL) + 12345uL;
+    ids[i] = i;
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[i], 100 + ((seed >> 16) % 500), schedLogCallback, &ids[i]));
+  }
+
+  /* Cancel every fourth timer again */
+  for( i = 0; i < TIMER_RP2040_SCHED_MAX_TIMERS; i += 4 )
+  {
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStop(&timers[i]));
+  }
+
+  /* Nothing is due yet */
+  setVirtualTime(50);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(0, schedExpiryCount);
+
+  setVirtualTime(350);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  setVirtualTime(600);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+
+  TEST_ASSERT_EQUAL((TIMER_RP2040_SCHED_MAX_TIMERS * 3) / 4, schedExpiryCount);
+  for( i = 0; i < (int)schedExpiryCount; i++ )
+  {
+    TEST_ASSERT_TRUE(timers[schedExpiryLog[i]].deadline >= lastDeadline);
+    TEST_ASSERT_TRUE(0 != (schedExpiryLog[i] % 4));
+    lastDeadline = timers[schedExpiryLog[i]].deadline;
+  }
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SchedCount);
+}
+
+void test_Sched_Process_FarDeadlineUsesIntermediateWake(void)
+{
+  static tTimer_RP2040_SoftTimer timer;
+  static uint32 id = 7;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+  setVirtualTime(1000);
+
+  /* Roughly two 32 bit epochs away */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timer, 0x200000000uLL, schedLogCallback, &id));
+  TEST_ASSERT_EQUAL(1000 + TIMER_RP2040_SCHED_MAX_SLEEP_US, Timer_Live.ALARM0);
+
+  /* The intermediate wake is served by the driver and does not reach the scheduler */
+  setVirtualTime(1000 + TIMER_RP2040_SCHED_MAX_SLEEP_US);
+  Timer_Live.INTS = INT_TO_BITMAP(TIMER_RP2040_SCHED_ALARM_INDEX);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(0, schedExpiryCount);
+  TEST_ASSERT_TRUE(Timer_RP2040_SchedIsActive(&timer));
+
+  setVirtualTime(0x200000000uLL);
+  Timer_RP2040_IrqHandler();
+  TEST_ASSERT_EQUAL(1, schedExpiryCount);
+  TEST_ASSERT_EQUAL(7, schedExpiryLog[0]);
+}
+
+void test_Sched_Window_CoalescesOverlappingTimers(void)
+{
+  static tTimer_RP2040_SoftTimer timers[3];
+  static uint32 ids[3] = { 0, 1, 2 };
+  tTimer_RP2040_SchedStats stats;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  /* Windows [10000, 15000], [12000, 13000] and [14000, 14000] - the alarm waits for the first window to close */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStartWindow(&timers[0], 10000, 5000, schedLogCallback, &ids[0]));
+  TEST_ASSERT_EQUAL(15000, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStartWindow(&timers[1], 12000, 1000, schedLogCallback, &ids[1]));
+  TEST_ASSERT_EQUAL(13000, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[2], 14000, schedLogCallback, &ids[2]));
+  TEST_ASSERT_EQUAL(13000, Timer_Live.ALARM0);
+  TEST_ASSERT_EQUAL_UINT64(13000, Timer_RP2040_SchedTimeToNext());
+
+  /* Both open windows are served by one wake, the third one has not opened yet */
+  setVirtualTime(13000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(2, schedExpiryCount);
+  TEST_ASSERT_EQUAL(0, schedExpiryLog[0]);
+  TEST_ASSERT_EQUAL(1, schedExpiryLog[1]);
+  TEST_ASSERT_EQUAL(14000, Timer_Live.ALARM0);
+
+  setVirtualTime(14000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(3, schedExpiryCount);
+
+  TEST_ASSERT_EQUAL(E_INVALID_PARAM, Timer_RP2040_SchedCoalesceStats(NULL));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedCoalesceStats(&stats));
+  TEST_ASSERT_EQUAL(3, stats.expired);
+  TEST_ASSERT_EQUAL(2, stats.wakes);
+  TEST_ASSERT_EQUAL(1, stats.saved);
+  TEST_ASSERT_EQUAL_UINT64(4000, stats.lateTotal);
+}
+#endif /* TIMER_RP2040_SCHED_BACKEND_HEAP */
+
+#if ( TIMER_RP2040_SCHED_BACKEND == TIMER_RP2040_SCHED_BACKEND_WHEEL )
+#if ( TIMER_RP2040_TICKLESS == 0 )
+void test_Sched_Wheel_Init_ArmsNextTick(void)
+{
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(2500);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedInit());
+  TEST_ASSERT_EQUAL(3000, Timer_Live.ALARM0);
+
+  /* Each processed tick arms the following one */
+  setVirtualTime(3000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(4000, Timer_Live.ALARM0);
+}
+#endif
+
+void test_Sched_Wheel_ExpiresOnFirstTickAfterDeadline(void)
+{
+  /* Deadlines on level 0, level 1, level 2 and level 3 of the wheel */
+  static tTimer_RP2040_SoftTimer timers[5];
+  static uint32 ids[5] = { 0, 1, 2, 3, 4 };
+  static const uint64 deadlines[5] = { 1500, 2000, 70001, 4200000, 270000000 };
+  uint64 firedAt[5] = { 0 };
+  uint64 time;
+  uint32 logged = 0;
+  int i;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  for( i = 0; i < 5; i++ )
+  {
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[i], deadlines[i], schedLogCallback, &ids[i]));
+  }
+
+  /* Tick every 1ms until 5 seconds, then jump - the wheel catches up tick by tick */
+  for( time = 1000; time <= 5000000; time += 1000 )
+  {
+    setVirtualTime(time);
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+    while( logged < schedExpiryCount )
+    {
+      firedAt[schedExpiryLog[logged]] = time;
+      logged++;
+    }
+  }
+  setVirtualTime(270000000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(5, schedExpiryCount);
+  TEST_ASSERT_EQUAL(4, schedExpiryLog[4]);
+
+  TEST_ASSERT_EQUAL_UINT64(2000, firedAt[0]);
+  TEST_ASSERT_EQUAL_UINT64(2000, firedAt[1]);
+  TEST_ASSERT_EQUAL_UINT64(71000, firedAt[2]);
+  TEST_ASSERT_EQUAL_UINT64(4200000, firedAt[3]);
+  TEST_ASSERT_EQUAL(0, Timer_RP2040_SchedCount);
+}
+
+void test_Sched_Wheel_StopAndRestart(void)
+{
+  static tTimer_RP2040_SoftTimer timers[2];
+  static uint32 ids[2] = { 0, 1 };
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  (void)Timer_RP2040_SchedStart(&timers[0], 3000, schedLogCallback, &ids[0]);
+  (void)Timer_RP2040_SchedStart(&timers[1], 3000, schedLogCallback, &ids[1]);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStop(&timers[0]));
+  TEST_ASSERT_FALSE(Timer_RP2040_SchedIsActive(&timers[0]));
+
+  /* Restarting a pending timer moves it */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[1], 9000, schedLogCallback, &ids[1]));
+  TEST_ASSERT_EQUAL(1, Timer_RP2040_SchedCount);
+
+  setVirtualTime(5000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(0, schedExpiryCount);
+
+  setVirtualTime(9000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(1, schedExpiryCount);
+  TEST_ASSERT_EQUAL(1, schedExpiryLog[0]);
+}
+
+void test_Sched_Wheel_Window_MeetsOnAlignedTick(void)
+{
+  static tTimer_RP2040_SoftTimer timers[2];
+  static uint32 ids[2] = { 0, 1 };
+  tTimer_RP2040_SchedStats stats;
+  uint64 time;
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  /* Ticks [2, 5] and [3, 7] - both pick tick 4, the one with the most trailing zero bits */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStartWindow(&timers[0], 1500, 3500, schedLogCallback, &ids[0]));
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStartWindow(&timers[1], 2500, 4500, schedLogCallback, &ids[1]));
+
+  for( time = 1000; time <= 3000; time += 1000 )
+  {
+    setVirtualTime(time);
+    TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  }
+  TEST_ASSERT_EQUAL(0, schedExpiryCount);
+
+  setVirtualTime(4000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(2, schedExpiryCount);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedCoalesceStats(&stats));
+  TEST_ASSERT_EQUAL(2, stats.expired);
+  TEST_ASSERT_EQUAL(1, stats.wakes);
+  TEST_ASSERT_EQUAL(1, stats.saved);
+}
+
+#if ( TIMER_RP2040_TICKLESS != 0 )
+void test_Sched_Wheel_Tickless_WakesOnlyForWork(void)
+{
+  static tTimer_RP2040_SoftTimer timers[2];
+  static uint32 ids[2] = { 0, 1 };
+  Timer_RP2040_Status = TIMER_RP2040_INIT;
+  setVirtualTime(0);
+  (void)Timer_RP2040_SchedInit();
+  schedExpiryCount = 0;
+
+  /* An empty wheel leaves the alarm disarmed */
+  TEST_ASSERT_EQUAL(0, Timer_Live.ALARM0);
+
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[0], 5000, schedLogCallback, &ids[0]));
+  TEST_ASSERT_EQUAL(5000, Timer_Live.ALARM0);
+
+  /* A level 1 timer first wakes the wheel at its cascade tick */
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedStart(&timers[1], 200000, schedLogCallback, &ids[1]));
+  TEST_ASSERT_EQUAL(5000, Timer_Live.ALARM0);
+
+  setVirtualTime(5000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(1, schedExpiryCount);
+  TEST_ASSERT_EQUAL(192000, Timer_Live.ALARM0);
+
+  setVirtualTime(192000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(1, schedExpiryCount);
+  TEST_ASSERT_EQUAL(200000, Timer_Live.ALARM0);
+
+  setVirtualTime(200000);
+  TEST_ASSERT_EQUAL(E_OK, Timer_RP2040_SchedProcess());
+  TEST_ASSERT_EQUAL(2, schedExpiryCount);
+  TEST_ASSERT_EQUAL(1, schedExpiryLog[1]);
+  TEST_ASSERT_EQUAL(TIMER_RP2040_ALARM_NOT_SET, Timer_RP2040_CheckAlarmN(ALARM0_INDEX));
+}
+#endif
+#endif /* TIMER_RP2040_SCHED_BACKEND_WHEEL */
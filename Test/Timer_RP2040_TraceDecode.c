@@ -0,0 +1,91 @@
+/**
+ *
+* @file "Timer_RP2040_TraceDecode.c"
+* @author Madrick3
+* @brief Host decoder for trace images made by Timer_RP2040_TraceExport (VIRTUAL_TARGET build). Reads an image from
+* the file given as the only argument, or from stdin, and prints one comma separated row per record:
+*   time_us,event,argument
+* 'time_us' counts from the base time of the image. The number of records dropped before the image was taken is
+* reported on stderr.
+*
+* @COMPONENT: TIMER_RP2040
+* @VERSION: 01.01.00
+*/
+/************************************************************
+  Version History
+  -----------------------------------------------------------
+  Revision |  Author   |  Change ID  |  Description
+  01.01.00 |  Madrick3 |  user-016   |  Initial Creation
+************************************************************/
+
+/************************************************************
+  INCLUDES
+************************************************************/
+#include <stdio.h>
+#include "Timer_RP2040_Trace.h"
+
+/************************************************************
+  DEFINES
+************************************************************/
+
+/* Largest image accepted - rings of up to 1MB */
+#define DECODE_MAX_IMAGE (TIMER_RP2040_TRACE_HEADER_BYTES + 0x100000uL)
+
+/************************************************************
+  LOCAL VARIABLES
+************************************************************/
+static uint8 decodeImage[DECODE_MAX_IMAGE];
+
+/************************************************************
+  MAIN
+************************************************************/
+int main ( int argc, char ** argv )
+{
+  FILE * input = stdin;
+  uint32 length;
+  uint64 base;
+  tTimer_RP2040_TraceReader reader;
+  tTimer_RP2040_TraceEvent event;
+  Std_ErrorCode retVal;
+
+  if( argc > 2 )
+  {
+    fprintf(stderr, "usage: %s [image]\n", argv[0]);
+    return 2;
+  }
+
+  if( (2 == argc) && (NULL == (input = fopen(argv[1], "rb"))) )
+  {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 2;
+  }
+
+  length = (uint32)fread(decodeImage, 1, sizeof(decodeImage), input);
+  if( stdin != input )
+  {
+    (void)fclose(input);
+  }
+
+  if( E_OK != Timer_RP2040_TraceReaderInit(&reader, decodeImage, length) )
+  {
+    fprintf(stderr, "not a trace image\n");
+    return 1;
+  }
+
+  base = reader.time;
+  fprintf(stderr, "dropped records: %lu\n", (unsigned long)reader.dropped);
+  printf("time_us,event,argument\n");
+
+  while( E_OK == (retVal = Timer_RP2040_TraceNext(&reader, &event)) )
+  {
+    printf("%lu,%u,%lu\n", (unsigned long)(event.time - base), (unsigned)event.id, (unsigned long)event.argument);
+  }
+
+  if( E_NOT_OK != retVal )
+  {
+    fprintf(stderr, "truncated record\n");
+    return 1;
+  }
+
+  return 0;
+}